@@ -13,106 +13,118 @@
 
 #include <dispatcher.hpp>
 
+#include <dynd/callable.hpp>
 #include <dynd/dispatcher.hpp>
 #include <dynd/type.hpp>
 #include <dynd/type_registry.hpp>
+#include <dynd/types/option_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
-template <size_t N>
-class DispatchFixture : public ::benchmark::Fixture {
-public:
-  vector<type_id_t[N]> ids;
+namespace {
 
-  void SetUp(const benchmark::State &state) {
-    ids.resize(state.range_x());
-
-    default_random_engine generator;
-    uniform_int_distribution<underlying_type_t<type_id_t>> d(bool_id, callable_id);
+class null_callable : public nd::base_callable {
+public:
+  null_callable(const ndt::type &tp) : base_callable(tp) {}
 
-    for (auto &id : ids) {
-      for (size_t i = 0; i < N; ++i) {
-        id[i] = static_cast<type_id_t>(d(generator));
-      }
-    }
+  ndt::type resolve(nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), nd::call_graph &DYND_UNUSED(cg),
+                    const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                    size_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
+                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+    return dst_tp;
   }
 };
 
-template <>
-class DispatchFixture<1> : public ::benchmark::Fixture {
+std::vector<ndt::type> dispatch_args(const ndt::type &DYND_UNUSED(dst_tp), size_t nsrc, const ndt::type *src_tp) {
+  return std::vector<ndt::type>(src_tp, src_tp + nsrc);
+}
+
+std::vector<ndt::type> builtin_types() {
+  return {ndt::make_type<bool1>(),    ndt::make_type<int8_t>(),   ndt::make_type<int16_t>(),
+          ndt::make_type<int32_t>(),  ndt::make_type<int64_t>(),  ndt::make_type<int128>(),
+          ndt::make_type<uint8_t>(),  ndt::make_type<uint16_t>(), ndt::make_type<uint32_t>(),
+          ndt::make_type<uint64_t>(), ndt::make_type<uint128>(),  ndt::make_type<float16>(),
+          ndt::make_type<float>(),    ndt::make_type<double>(),   ndt::make_type<float128>(),
+          ndt::make_type<dynd::complex<float>>(), ndt::make_type<dynd::complex<double>>()};
+}
+
+} // unnamed namespace
+
+/**
+ * Builds a binary dispatcher with ``state.range_x()`` exact overloads, and
+ * lookups that are spread uniformly over them. With builtin argument types the
+ * lookups hit the memo, whereas with option types they scan the overloads.
+ */
+template <bool Builtin>
+class DispatchFixture : public ::benchmark::Fixture {
 public:
-  vector<pair<type_id_t, type_id_t>> pairs;
+  std::unique_ptr<dispatcher<2, nd::callable>> d;
+  vector<std::array<ndt::type, 2>> lookups;
 
   void SetUp(const benchmark::State &state) {
-    pairs.resize(state.range_x());
-
-    default_random_engine generator;
-    uniform_int_distribution<underlying_type_t<type_id_t>> d(bool_id, callable_id);
+    vector<ndt::type> tps = builtin_types();
+    if (!Builtin) {
+      for (ndt::type &tp : tps) {
+        tp = ndt::make_type<ndt::option_type>(tp);
+      }
+    }
 
-    for (auto &pair : pairs) {
-      pair.first = static_cast<type_id_t>(d(generator));
-      pair.second = static_cast<type_id_t>(d(generator));
+    vector<nd::callable> children;
+    vector<std::array<ndt::type, 2>> signatures;
+    for (const ndt::type &tp0 : tps) {
+      for (const ndt::type &tp1 : tps) {
+        if (children.size() < static_cast<size_t>(state.range_x())) {
+          children.push_back(nd::make_callable<null_callable>(
+              ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {tp0, tp1})));
+          signatures.push_back({{tp0, tp1}});
+        }
+      }
     }
-  }
-};
 
-typedef DispatchFixture<1> X;
+    d.reset(new dispatcher<2, nd::callable>(dispatch_args, children.begin(), children.end()));
 
-/*
-BENCHMARK_DEFINE_F(X, BM_IsBaseIDOf)(benchmark::State &state)
-{
-  while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
-      benchmark::DoNotOptimize(is_base_id_of(pair.first, pair.second));
+    default_random_engine generator;
+    uniform_int_distribution<size_t> index(0, signatures.size() - 1);
+
+    lookups.resize(1000);
+    for (auto &lookup : lookups) {
+      lookup = signatures[index(generator)];
     }
   }
-  state.SetItemsProcessed(10 * state.iterations() * state.range_x());
-}
 
-BENCHMARK_REGISTER_F(X, BM_IsBaseIDOf)->Arg(100)->Arg(1000)->Arg(10000);
-*/
+  void TearDown(const benchmark::State &DYND_UNUSED(state)) {
+    d.reset();
+    lookups.clear();
+  }
+};
 
-typedef DispatchFixture<1> UnaryDispatchFixture;
-typedef DispatchFixture<2> BinaryDispatchFixture;
+typedef DispatchFixture<true> BuiltinDispatchFixture;
+typedef DispatchFixture<false> OptionDispatchFixture;
 
-/*
-BENCHMARK_DEFINE_F(BinaryDispatchFixture, BM_Supercedes)(benchmark::State &state)
-{
+BENCHMARK_DEFINE_F(BuiltinDispatchFixture, BM_BinaryDispatch)(benchmark::State &state) {
+  ndt::type dst_tp = ndt::make_type<void>();
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(supercedes(pair.first, pair.second));
+    for (const auto &lookup : lookups) {
+      benchmark::DoNotOptimize((*d)(dst_tp, 2, lookup.data()).get());
     }
   }
-  state.SetItemsProcessed(state.iterations() * state.range_x());
+  state.SetItemsProcessed(state.iterations() * lookups.size());
 }
-*/
 
-// BENCHMARK_REGISTER_F(BinaryDispatchFixture, BM_Supercedes)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_REGISTER_F(BuiltinDispatchFixture, BM_BinaryDispatch)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
 
-BENCHMARK_DEFINE_F(UnaryDispatchFixture, BM_UnaryDispatch)(benchmark::State &state) {
-  dispatcher<1, int> dispatcher{{{any_kind_id}, 0}, {{scalar_kind_id}, 1}, {{bool_id}, 2},    {{int8_id}, 3},
-                                {{int16_id}, 4},    {{int32_id}, 5},       {{int64_id}, 6},   {{int128_id}, 7},
-                                {{uint8_id}, 8},    {{uint16_id}, 9},      {{uint32_id}, 10}, {{uint64_id}, 11},
-                                {{uint128_id}, 12}, {{float32_id}, 13},    {{float64_id}, 14}};
+BENCHMARK_DEFINE_F(OptionDispatchFixture, BM_BinaryDispatch)(benchmark::State &state) {
+  ndt::type dst_tp = ndt::make_type<void>();
   while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(dispatcher(pair.first));
+    for (const auto &lookup : lookups) {
+      benchmark::DoNotOptimize((*d)(dst_tp, 2, lookup.data()).get());
     }
   }
-  state.SetItemsProcessed(state.iterations() * state.range_x());
+  state.SetItemsProcessed(state.iterations() * lookups.size());
 }
 
-BENCHMARK_REGISTER_F(UnaryDispatchFixture, BM_UnaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK_REGISTER_F(OptionDispatchFixture, BM_BinaryDispatch)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
 
 /*
 static void BM_VirtualDispatch(benchmark::State &state)
@@ -124,19 +136,3 @@ static void BM_VirtualDispatch(benchmark::State &state)
 
 BENCHMARK(BM_VirtualDispatch);
 */
-
-BENCHMARK_DEFINE_F(UnaryDispatchFixture, BM_BinaryDispatch)(benchmark::State &state) {
-  dispatcher<2, int> dispatcher{{{any_kind_id, int64_id}, 0},
-                                {{scalar_kind_id, int64_id}, 1},
-                                {{int32_id, int64_id}, 2},
-                                {{float32_id, int64_id}, 3},
-                                {{any_kind_id, any_kind_id}, 4}};
-  while (state.KeepRunning()) {
-    for (const auto &pair : pairs) {
-      benchmark::DoNotOptimize(dispatcher(pair.first, pair.second));
-    }
-  }
-  state.SetItemsProcessed(state.iterations() * state.range_x());
-}
-
-BENCHMARK_REGISTER_F(UnaryDispatchFixture, BM_BinaryDispatch)->Arg(100)->Arg(1000)->Arg(10000);
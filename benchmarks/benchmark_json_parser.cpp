@@ -0,0 +1,63 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/json_parser.hpp>
+#include <dynd/kernels/simd.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static std::string make_records(int count) {
+  std::string res = "[";
+  for (int i = 0; i < count; ++i) {
+    res += i == 0 ? "\n" : ",\n";
+    res += "  {\"id\": " + std::to_string(i) + ", \"host\": \"web-" + std::to_string(i % 16) +
+           ".example.com\", \"path\": \"/api/v1/items/" + std::to_string(i * 7) +
+           "\", \"status\": 200, \"latency\": 0.0" + std::to_string(i % 1000) +
+           ", \"tags\": [\"alpha\", \"beta\"], \"user_agent\": \"Mozilla/5.0 (X11; Linux x86_64)\"}";
+  }
+  res += "\n]";
+
+  return res;
+}
+
+// The second argument selects the character by character parser (0) or the
+// two pass parser with the structural index (1)
+static void BM_JSONParser_Records(benchmark::State &state) {
+  std::string json = make_records(state.range_x());
+  ndt::type tp("var * {id: int64, host: string, path: string, status: int32, latency: float64, tags: var * string}");
+  set_simd_isa(state.range_y() ? detected_simd_isa() : simd_none);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(parse_json(tp, json.c_str()));
+  }
+  set_simd_isa(detected_simd_isa());
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_JSONParser_Records)->ArgPair(1 << 10, 0)->ArgPair(1 << 10, 1)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+
+static void BM_JSONParser_Numbers(benchmark::State &state) {
+  std::string json = "[";
+  for (int i = 0; i < state.range_x(); ++i) {
+    json += (i == 0 ? "" : ", ") + std::to_string(i * 31);
+  }
+  json += "]";
+
+  ndt::type tp("var * int64");
+  set_simd_isa(state.range_y() ? detected_simd_isa() : simd_none);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(parse_json(tp, json.c_str()));
+  }
+  set_simd_isa(detected_simd_isa());
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_JSONParser_Numbers)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
@@ -3,35 +3,77 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
-#include <iostream>
-#include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <iostream>
+#include <stdexcept>
 
 #include <benchmark/benchmark.h>
 
-#include <dynd/func/arithmetic.hpp>
-#include <dynd/func/random.hpp>
+#include "../../tests/test_scoped_state.hpp"
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/kernels/simd.hpp>
 
 using namespace std;
 using namespace dynd;
 
-static const int size = 10000; // 256 * 256
+template <typename T>
+static nd::array make_contiguous(intptr_t size) {
+  nd::array a = nd::empty(size, ndt::make_type<T>());
+  T *data = reinterpret_cast<T *>(a.data());
+  for (intptr_t i = 0; i < size; ++i) {
+    data[i] = static_cast<T>(i % 100);
+  }
+
+  return a;
+}
 
-static void BM_Func_Arithmetic_Add(benchmark::State &state)
-{
-  nd::array a = nd::random::uniform({}, {{"dst_tp", ndt::make_fixed_dim(size, ndt::make_type<float>())}});
-  nd::array b = nd::random::uniform({}, {{"dst_tp", ndt::make_fixed_dim(size, ndt::make_type<float>())}});
-  nd::array c = nd::empty(ndt::make_fixed_dim(size, ndt::make_type<float>()));
+// The second argument selects the generic loop (0) or the SIMD loop for the
+// widest instruction set the CPU supports (1)
+template <typename T>
+static void BM_Func_Arithmetic_Add(benchmark::State &state) {
+  nd::array a = make_contiguous<T>(state.range_x());
+  nd::array b = make_contiguous<T>(state.range_x());
+  scoped_simd_isa isa(state.range_y() ? detected_simd_isa() : simd_none);
   while (state.KeepRunning()) {
-    nd::add(a, b);
+    benchmark::DoNotOptimize(nd::add(a, b));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Func_Arithmetic_Add, int)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+BENCHMARK_TEMPLATE(BM_Func_Arithmetic_Add, float)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+BENCHMARK_TEMPLATE(BM_Func_Arithmetic_Add, double)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+
+template <typename T>
+static void BM_Func_Arithmetic_Multiply(benchmark::State &state) {
+  nd::array a = make_contiguous<T>(state.range_x());
+  nd::array b = make_contiguous<T>(state.range_x());
+  scoped_simd_isa isa(state.range_y() ? detected_simd_isa() : simd_none);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(nd::multiply(a, b));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Func_Arithmetic_Multiply, float)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+BENCHMARK_TEMPLATE(BM_Func_Arithmetic_Multiply, double)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+
+template <typename T>
+static void BM_Func_Comparison_Less(benchmark::State &state) {
+  nd::array a = make_contiguous<T>(state.range_x());
+  nd::array b = make_contiguous<T>(state.range_x());
+  scoped_simd_isa isa(state.range_y() ? detected_simd_isa() : simd_none);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(nd::less(a, b));
   }
 }
 
-BENCHMARK(BM_Func_Arithmetic_Add);
+BENCHMARK_TEMPLATE(BM_Func_Comparison_Less, int)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+BENCHMARK_TEMPLATE(BM_Func_Comparison_Less, float)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
+BENCHMARK_TEMPLATE(BM_Func_Comparison_Less, double)->ArgPair(1 << 16, 0)->ArgPair(1 << 16, 1);
 
-static void BM_Func_Arithmetic_Dispatch_time(benchmark::State &state)
-{
+static void BM_Func_Arithmetic_Dispatch_time(benchmark::State &state) {
   nd::array a = 5;
   nd::array b = (short)6;
   while (state.KeepRunning()) {
@@ -44,8 +86,7 @@ static void BM_Func_Arithmetic_Dispatch_time(benchmark::State &state)
 
 BENCHMARK(BM_Func_Arithmetic_Dispatch_time);
 
-static void BM_Func_Arithmetic_Dispatch_time_2(benchmark::State &state)
-{
+static void BM_Func_Arithmetic_Dispatch_time_2(benchmark::State &state) {
   nd::array a = (char)2;
   nd::array b = (dynd::complex128)1.;
   while (state.KeepRunning()) {
@@ -56,8 +97,7 @@ static void BM_Func_Arithmetic_Dispatch_time_2(benchmark::State &state)
 
 BENCHMARK(BM_Func_Arithmetic_Dispatch_time_2);
 
-static void BM_Func_Arithmetic_Dispatch_time_3(benchmark::State &state)
-{
+static void BM_Func_Arithmetic_Dispatch_time_3(benchmark::State &state) {
   nd::array a = (char)2;
   while (state.KeepRunning()) {
     nd::add(a, a);
@@ -66,8 +106,7 @@ static void BM_Func_Arithmetic_Dispatch_time_3(benchmark::State &state)
 
 BENCHMARK(BM_Func_Arithmetic_Dispatch_time_3);
 
-static void BM_Func_Arithmetic_Dispatch_time_4(benchmark::State &state)
-{
+static void BM_Func_Arithmetic_Dispatch_time_4(benchmark::State &state) {
   nd::array b = (dynd::complex128)1.;
   while (state.KeepRunning()) {
     nd::add(b, b);
@@ -740,17 +740,59 @@ namespace nd {
   }
 
   /**
-   * Memory-maps a file with dynd type 'bytes'.
+   * Memory-maps the bytes of a file as a one-dimensional ``uint8`` array.
    *
    * \param filename  The name of the file to memory map.
    * \param begin  If provided, the start of where to memory map. Uses
    *               Python semantics for out of bounds and negative values.
    * \param end  If provided, the end of where to memory map. Uses
    *             Python semantics for out of bounds and negative values.
-   * \param access  The access permissions with which to open the file.
+   * \param access  The access permissions with which to open the file. With
+   *                write_access_flag, writes to the array go to the file.
+   * \param flags  A combination of the memmap_flags access hints, for
+   *               example memmap_sequential_flag | memmap_willneed_flag.
    */
   DYND_API array memmap(const std::string &filename, intptr_t begin = 0,
-                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = default_access_flags);
+                        intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t access = read_access_flag,
+                        uint32_t flags = 0);
+
+  /**
+   * Memory-maps a file as an array of type ``tp`` starting at ``offset``,
+   * without reading or copying any data. The type must have a fixed layout,
+   * i.e. no strings or var dims, and is laid out C-contiguously. If its
+   * outermost dimension is the symbolic ``Fixed``, it is sized to all the
+   * elements from the offset to the end of the file.
+   *
+   * The result keeps the mapping alive. Use memmap_flush to write the changes
+   * made through a writable map back to the file.
+   *
+   * \param filename  The name of the file to memory map.
+   * \param tp  The type of the data in the file, e.g. "Fixed * float64".
+   * \param offset  The position of the data in the file, which must be a
+   *                multiple of the alignment of the type.
+   * \param access  The access permissions with which to open the file.
+   * \param flags  A combination of the memmap_flags access hints.
+   */
+  DYND_API array memmap(const std::string &filename, const ndt::type &tp, intptr_t offset = 0,
+                        uint32_t access = read_access_flag, uint32_t flags = 0);
+
+  /**
+   * Writes the modified pages of the memory-mapped file that ``a`` views back
+   * to the file (msync). Only the pages under the data of ``a`` are flushed,
+   * not the whole mapping. With ``async`` set, the writes are only scheduled.
+   */
+  DYND_API void memmap_flush(const array &a, bool async = false);
+
+  /**
+   * Creates a one-dimensional string array from the values [begins[i],
+   * ends[i]). The values that are too long to be stored inside their strings
+   * share one arena owned by the array's memory block, so building and
+   * destroying the array costs a constant number of allocations. Assigning
+   * to its elements afterwards works as for any other string array.
+   */
+  DYND_API array make_string_array(intptr_t size, const char *const *begins, const char *const *ends);
+
+  DYND_API array make_string_array(const std::vector<std::string> &values);
 
   /**
    * Creates a ctuple nd::array with the given field names and
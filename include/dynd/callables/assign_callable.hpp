@@ -262,7 +262,8 @@ namespace nd {
           size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
         kb.emplace_back<detail::assignment_kernel<ndt::fixed_string_type, string, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src0_encoding, error_mode),
-            get_append_unicode_codepoint_function(dst_encoding, error_mode), dst_data_size,
+            get_append_unicode_codepoint_function(dst_encoding, error_mode),
+            get_transcode_ascii_function(dst_encoding, src0_encoding), dst_data_size,
             error_mode != assign_error_nocheck);
       });
 
@@ -288,12 +289,13 @@ namespace nd {
                           const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
                           const char *const *DYND_UNUSED(src_arrmeta)) {
         const ndt::fixed_string_type *src_fs = src_tp[0].extended<ndt::fixed_string_type>();
+        string_encoding_t dst_encoding = dst_tp.extended<ndt::fixed_string_type>()->get_encoding();
         kb.emplace_back<
             detail::assignment_kernel<ndt::fixed_string_type, ndt::fixed_string_type, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src_fs->get_encoding(), error_mode),
-            get_append_unicode_codepoint_function(dst_tp.extended<ndt::fixed_string_type>()->get_encoding(),
-                                                  error_mode),
-            dst_tp.get_data_size(), src_fs->get_data_size(), error_mode != assign_error_nocheck);
+            get_append_unicode_codepoint_function(dst_encoding, error_mode),
+            get_transcode_ascii_function(dst_encoding, src_fs->get_encoding()), dst_tp.get_data_size(),
+            src_fs->get_data_size(), error_mode != assign_error_nocheck);
       });
 
       return dst_tp;
@@ -474,7 +476,8 @@ namespace nd {
           size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
         kb.emplace_back<detail::assignment_kernel<ndt::fixed_string_type, string, assign_error_nocheck>>(
             kernreq, get_next_unicode_codepoint_function(src0_encoding, error_mode),
-            get_append_unicode_codepoint_function(dst_encoding, error_mode), dst_data_size,
+            get_append_unicode_codepoint_function(dst_encoding, error_mode),
+            get_transcode_ascii_function(dst_encoding, src0_encoding), dst_data_size,
             error_mode != assign_error_nocheck);
       });
 
@@ -10,6 +10,7 @@
 #include <typeinfo>
 
 #include <dynd/array.hpp>
+#include <dynd/callables/call_cache.hpp>
 #include <dynd/callables/call_graph.hpp>
 #include <dynd/kernels/kernel_prefix.hpp>
 #include <dynd/types/callable_type.hpp>
@@ -53,6 +54,16 @@ namespace nd {
   protected:
     std::atomic_long m_use_count;
     ndt::type m_tp;
+    call_cache m_cache;
+
+    /**
+     * Resolves a call into a call graph, reusing a previously resolved one
+     * for the same types if possible. Calls with keyword arguments are never
+     * cached, as their resolution may depend on the keyword values.
+     */
+    std::shared_ptr<call_cache::entry> resolve_cached(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
+                                                      size_t nkwd, const array *kwds,
+                                                      const std::map<std::string, ndt::type> &tp_vars);
 
   public:
     base_callable(const ndt::type &tp) : m_use_count(0), m_tp(tp) {}
@@ -90,6 +101,8 @@ namespace nd {
 
     bool is_kwd_variadic() const { return m_tp.extended<ndt::callable_type>()->is_kwd_variadic(); }
 
+    call_cache &get_call_cache() { return m_cache; }
+
     /**
      * Function prototype for instantiating a kernel from an
      * callable. To use this function, the
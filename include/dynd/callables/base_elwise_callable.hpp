@@ -6,6 +6,8 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <vector>
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -15,6 +17,13 @@ namespace dynd {
 namespace nd {
   namespace functional {
 
+    /**
+     * The broadcast flags of the arguments for a run of fixed dimensions that
+     * are resolved one after the other. The kernel of the first dimension reads
+     * the whole run, so it can coalesce and reorder the loops of all of them.
+     */
+    typedef std::vector<std::vector<bool>> elwise_fixed_run;
+
     template <size_t N>
     class base_elwise_callable : public base_callable {
     protected:
@@ -24,6 +33,7 @@ namespace nd {
         bool state;
         size_t ndim;
         bool first;
+        std::shared_ptr<elwise_fixed_run> fixed_run;
       };
 
       struct data_type {
@@ -32,8 +42,18 @@ namespace nd {
         intptr_t res_alignment;
         size_t ndim;
         bool res_ignore;
+        bool parallel;
+        std::shared_ptr<elwise_fixed_run> fixed_run;
       };
 
+      /**
+       * Returns true if kernels of the type may run concurrently on disjoint
+       * elements, i.e. they neither allocate into nor reference memory blocks.
+       */
+      static bool is_parallel_safe(const ndt::type &tp) {
+        return !tp.is_symbolic() && (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) == 0;
+      }
+
     public:
       base_elwise_callable() : base_callable(ndt::type()) {}
 
@@ -74,6 +94,15 @@ namespace nd {
           data.arg_var[i] = arg_tp[i].get_id() == var_dim_id;
         }
 
+        // Nullary callables are typically generators with shared state, so
+        // only elementwise operations with arguments may run in parallel
+        data.parallel = N > 0 && !res_ignore;
+        for (size_t i = 0; i < N; ++i) {
+          data.parallel = data.parallel && is_parallel_safe(arg_tp[i]);
+        }
+        data.parallel =
+            data.parallel && (res_tp.is_symbolic() ? is_parallel_safe(child_ret_tp) : is_parallel_safe(res_tp));
+
         intptr_t res_size;
         ndt::type res_element_tp;
         if (res_ignore) {
@@ -103,8 +132,20 @@ namespace nd {
           }
         }
 
+        // A fixed dimension joins the run of those resolved just before it
+        std::shared_ptr<elwise_fixed_run> &fixed_run = reinterpret_cast<codata_type *>(codata)->fixed_run;
+        if (!fixed_run) {
+          fixed_run = std::make_shared<elwise_fixed_run>();
+        }
+        data.fixed_run = fixed_run;
+        size_t fixed_run_size = fixed_run->size();
+
         subresolve(cg, reinterpret_cast<char *>(&data));
 
+        if (fixed_run->size() == fixed_run_size) {
+          fixed_run.reset();
+        }
+
         if (--reinterpret_cast<codata_type *>(codata)->ndim > 0) {
           res_element_tp =
               caller->resolve(this, codata, cg, res_element_tp, N, arg_element_tp.data(), nkwd, kwds, tp_vars);
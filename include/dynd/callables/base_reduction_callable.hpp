@@ -26,12 +26,16 @@ namespace nd {
         const int *axes;
         int axis;
         intptr_t ndim;
+        callable_property properties;
       };
 
       struct node_type {
         bool inner;
         bool broadcast;
         bool keepdim;
+        // The size of the accumulator if the dimension may be split into chunks
+        // that are reduced in parallel, otherwise zero
+        intptr_t parallel_size;
       };
 
       base_reduction_callable() : base_callable(ndt::type()) {}
@@ -54,6 +58,7 @@ namespace nd {
         }
         node.broadcast = !reduce;
         node.keepdim = reinterpret_cast<data_type *>(data)->keepdims;
+        node.parallel_size = 0;
 
         std::vector<ndt::type> arg_element_tp(2);
         for (size_t i = 0; i < nsrc; ++i) {
@@ -68,6 +73,17 @@ namespace nd {
         ndt::type ret_element_tp;
         if (reinterpret_cast<data_type *>(data)->axis == reinterpret_cast<data_type *>(data)->ndim) {
           node.inner = true;
+          if (reduce && nsrc == 1 && (reinterpret_cast<data_type *>(data)->properties & left_associative) &&
+              arg_element_tp[0].is_builtin() && arg_element_tp[0].get_data_alignment() <= 8) {
+            // The partial results of the chunks start out as copies of their
+            // first element and are combined with the child itself, which is
+            // only valid if it accumulates into the type of its argument
+            call_graph probe_cg;
+            if (child->resolve(this, nullptr, probe_cg, child_ret_tp, nsrc, arg_element_tp.data(), nkwd - 2, kwds + 2,
+                               tp_vars) == arg_element_tp[0]) {
+              node.parallel_size = arg_element_tp[0].get_data_size();
+            }
+          }
           resolve(cg, reinterpret_cast<char *>(&node));
 
           ret_element_tp =
@@ -103,12 +119,40 @@ namespace nd {
         bool inner = reinterpret_cast<node_type *>(data)->inner;
         bool broadcast = reinterpret_cast<node_type *>(data)->broadcast;
         bool keepdim = reinterpret_cast<node_type *>(data)->keepdim;
+        intptr_t parallel_size = reinterpret_cast<node_type *>(data)->parallel_size;
 
-        cg.emplace_back([inner, broadcast, keepdim](kernel_builder &kb, kernel_request_t kernreq,
-                                                    char *DYND_UNUSED(data), const char *dst_arrmeta, size_t nsrc,
-                                                    const char *const *src_arrmeta) {
+        cg.emplace_back([inner, broadcast, keepdim, parallel_size](kernel_builder &kb, kernel_request_t kernreq,
+                                                                   char *DYND_UNUSED(data), const char *dst_arrmeta,
+                                                                   size_t nsrc, const char *const *src_arrmeta) {
           if (inner) {
-            if (!broadcast) {
+            const eval::eval_context &ectx = eval::default_eval_context;
+            if (parallel_size > 0 && ectx.nthreads != 1 && !in_parallel_region() &&
+                reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size >=
+                    2 * static_cast<intptr_t>(ectx.grain_size)) {
+              intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
+              intptr_t src_stride = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->stride;
+              size_t nthreads = (ectx.nthreads == 0) ? hardware_concurrency() : ectx.nthreads;
+
+              intptr_t root_ckb_offset = kb.size();
+              kb.emplace_back<parallel_reduction_kernel>(kernreq, src_size, src_stride, parallel_size, nthreads,
+                                                         ectx.grain_size);
+
+              const char *src_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
+
+              // Every worker reduces its chunks with its own instance of the child
+              call_node *child_call = kb.get_call();
+              nthreads = kb.get_at<parallel_reduction_kernel>(root_ckb_offset)->m_nthreads;
+              for (size_t i = 0; i < nthreads; ++i) {
+                intptr_t child_offset = kb.size() - root_ckb_offset;
+                kb.rewind(child_call);
+                kb(kernel_request_strided, nullptr, dst_arrmeta + sizeof(size_stride_t), nsrc, &src_element_arrmeta);
+                kb.get_at<parallel_reduction_kernel>(root_ckb_offset)->m_child_offset.push_back(child_offset);
+              }
+
+              intptr_t init_offset = kb.size();
+              kb(kernel_request_single, nullptr, dst_arrmeta + sizeof(size_stride_t), nsrc, &src_element_arrmeta);
+              kb.get_at<parallel_reduction_kernel>(root_ckb_offset)->m_init_offset = init_offset - root_ckb_offset;
+            } else if (!broadcast) {
               intptr_t src_size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
 
               typedef reduction_kernel<ndt::fixed_dim_type, false, true, NArg> self_type;
@@ -0,0 +1,116 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <dynd/callables/call_graph.hpp>
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A bounded, thread-safe LRU cache of resolved call graphs, keyed on the
+   * requested return type and the argument types of a call, and on the error
+   * mode of ``eval::default_eval_context``, which some callables read while
+   * resolving.
+   *
+   * Resolution only looks at types, so a cached call graph can be reused to
+   * instantiate a fresh kernel against whatever arrmeta the next call has.
+   * Entries are handed out as shared pointers, which keeps a call graph alive
+   * while it is being instantiated even if it is evicted concurrently.
+   *
+   * Calling ``invalidate_all`` flushes every cache lazily. This must happen
+   * whenever a callable changes how it resolves, e.g. when an overload is added
+   * to a dispatching callable that other callables may forward to.
+   */
+  class DYND_API call_cache {
+  public:
+    struct entry {
+      std::vector<ndt::type> key;
+      assign_error_mode errmode;
+      ndt::type res_tp;
+      call_graph cg;
+
+      entry(const ndt::type &res_tp, size_t narg, const ndt::type *arg_tp, assign_error_mode errmode)
+          : key(narg + 1), errmode(errmode) {
+        key[0] = res_tp;
+        for (size_t i = 0; i < narg; ++i) {
+          key[i + 1] = arg_tp[i];
+        }
+      }
+
+      bool matches(const ndt::type &res_tp, size_t narg, const ndt::type *arg_tp, assign_error_mode errmode) const {
+        if (this->errmode != errmode || key.size() != narg + 1 || key[0] != res_tp) {
+          return false;
+        }
+
+        for (size_t i = 0; i < narg; ++i) {
+          if (key[i + 1] != arg_tp[i]) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+    };
+
+    static const size_t default_capacity = 8;
+
+  private:
+    std::mutex m_mutex;
+    std::list<std::shared_ptr<entry>> m_entries;
+    size_t m_capacity;
+    long m_generation;
+
+    static std::atomic_long s_generation;
+
+    void flush_if_stale();
+
+  public:
+    call_cache(size_t capacity = default_capacity);
+
+    // non-copyable
+    call_cache(const call_cache &) = delete;
+
+    /**
+     * Returns the cached entry for the given types and marks it as the most
+     * recently used, or a null pointer if there is none.
+     */
+    std::shared_ptr<entry> find(const ndt::type &res_tp, size_t narg, const ndt::type *arg_tp,
+                                assign_error_mode errmode);
+
+    /**
+     * Adds a resolved entry, evicting the least recently used one if the
+     * cache is full.
+     */
+    void insert(const std::shared_ptr<entry> &e);
+
+    void clear();
+
+    size_t size();
+
+    size_t get_capacity() const { return m_capacity; }
+
+    /**
+     * Changes the maximum number of entries, with zero disabling the cache.
+     */
+    void set_capacity(size_t capacity);
+
+    /**
+     * Invalidates the entries of every call cache.
+     */
+    static void invalidate_all();
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -8,6 +8,7 @@
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/callables/base_elwise_callable.hpp>
 #include <dynd/kernels/elwise_kernel.hpp>
+#include <dynd/shape_tools.hpp>
 
 namespace dynd {
 namespace nd {
@@ -45,47 +46,181 @@ namespace nd {
     class elwise_callable<fixed_dim_id, fixed_dim_id, TraitsType, N> : public base_elwise_callable<N> {
       typedef typename base_elwise_callable<N>::data_type data_type;
 
+      /**
+       * Reorders the dimensions so the strides of the operands decrease from
+       * the outermost to the innermost one, as far as they agree.
+       */
+      static void reorder_by_strides(intptr_t ndim, intptr_t *size, intptr_t **stride) {
+        shortvector<int> axis_perm(ndim);
+        multistrides_to_axis_perm(ndim, N + 1, stride, axis_perm.get());
+
+        dimvector tmp(ndim);
+        for (int i = 0; i < static_cast<int>(N + 1); ++i) {
+          for (intptr_t j = 0; j < ndim; ++j) {
+            tmp[j] = stride[i][axis_perm[ndim - j - 1]];
+          }
+          memcpy(stride[i], tmp.get(), ndim * sizeof(intptr_t));
+        }
+        for (intptr_t j = 0; j < ndim; ++j) {
+          tmp[j] = size[axis_perm[ndim - j - 1]];
+        }
+        memcpy(size, tmp.get(), ndim * sizeof(intptr_t));
+      }
+
+      /**
+       * Returns true if some operands have a smaller stride along the outer
+       * dimension and others along the inner one.
+       */
+      static bool is_transposed(intptr_t **stride, intptr_t outer, intptr_t inner) {
+        bool outer_smaller = false, inner_smaller = false;
+        for (size_t i = 0; i < N + 1; ++i) {
+          intptr_t outer_stride = std::abs(stride[i][outer]), inner_stride = std::abs(stride[i][inner]);
+          if (outer_stride != 0 && inner_stride != 0) {
+            outer_smaller |= outer_stride < inner_stride;
+            inner_smaller |= inner_stride < outer_stride;
+          }
+        }
+
+        return outer_smaller && inner_smaller;
+      }
+
     public:
       void subresolve(call_graph &cg, const char *data) {
         bool res_broadcast = reinterpret_cast<const data_type *>(data)->res_ignore;
         const std::array<bool, N> &arg_broadcast = reinterpret_cast<const data_type *>(data)->arg_broadcast;
+        bool parallel =
+            std::is_same<TraitsType, no_traits>::value && reinterpret_cast<const data_type *>(data)->parallel;
+
+        // Kernels with state count the index of every dimension, so only the others join a run
+        std::shared_ptr<elwise_fixed_run> fixed_run;
+        size_t fixed_run_index = 0;
+        if (std::is_same<TraitsType, no_traits>::value) {
+          fixed_run = reinterpret_cast<const data_type *>(data)->fixed_run;
+          fixed_run_index = fixed_run->size();
+          fixed_run->emplace_back(arg_broadcast.begin(), arg_broadcast.end());
+        }
 
-        cg.emplace_back([res_broadcast, arg_broadcast](kernel_builder &kb, kernel_request_t kernreq, char *data,
-                                                       const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
-                                                       const char *const *src_arrmeta) {
-          size_t size;
-          if (res_broadcast) {
-            size = reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size;
-          } else {
-            size = reinterpret_cast<const size_stride_t *>(dst_arrmeta)->dim_size;
-          }
-
-          intptr_t dst_stride;
-          const char *child_dst_arrmeta;
-          if (res_broadcast) {
-            dst_stride = 0;
-            child_dst_arrmeta = dst_arrmeta;
-          } else {
-            dst_stride = reinterpret_cast<const size_stride_t *>(dst_arrmeta)->stride;
-            child_dst_arrmeta = dst_arrmeta + sizeof(size_stride_t);
-          }
+        cg.emplace_back([res_broadcast, arg_broadcast, parallel, fixed_run, fixed_run_index](
+            kernel_builder &kb, kernel_request_t kernreq, char *data, const char *dst_arrmeta,
+            size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+          // This dimension and the fixed ones that follow it in the run, outermost first
+          intptr_t run_ndim = fixed_run ? fixed_run->size() - fixed_run_index : 1;
 
-          std::array<intptr_t, N> src_stride;
+          dimvector size(run_ndim);
+          // The strides of the result, then of every argument
+          multi_shortvector<intptr_t, N + 1> stride(run_ndim);
+          const char *child_dst_arrmeta = dst_arrmeta;
           std::array<const char *, N> child_src_arrmeta;
           for (size_t i = 0; i < N; ++i) {
-            if (arg_broadcast[i]) {
-              src_stride[i] = 0;
-              child_src_arrmeta[i] = src_arrmeta[i];
+            child_src_arrmeta[i] = src_arrmeta[i];
+          }
+
+          for (intptr_t j = 0; j < run_ndim; ++j) {
+            if (res_broadcast) {
+              size[j] = reinterpret_cast<const size_stride_t *>(child_src_arrmeta[0])->dim_size;
+              stride.get(0, j) = 0;
             } else {
-              src_stride[i] = reinterpret_cast<const size_stride_t *>(src_arrmeta[i])->stride;
-              child_src_arrmeta[i] = src_arrmeta[i] + sizeof(size_stride_t);
+              size[j] = reinterpret_cast<const size_stride_t *>(child_dst_arrmeta)->dim_size;
+              stride.get(0, j) = reinterpret_cast<const size_stride_t *>(child_dst_arrmeta)->stride;
+              child_dst_arrmeta += sizeof(size_stride_t);
+            }
+
+            for (size_t i = 0; i < N; ++i) {
+              if (j == 0 ? arg_broadcast[i] : (*fixed_run)[fixed_run_index + j][i]) {
+                stride.get(i + 1, j) = 0;
+              } else {
+                stride.get(i + 1, j) = reinterpret_cast<const size_stride_t *>(child_src_arrmeta[i])->stride;
+                child_src_arrmeta[i] += sizeof(size_stride_t);
+              }
             }
           }
 
-          kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(kernreq, data, size, dst_stride,
-                                                                                    src_stride.data());
+          intptr_t ndim = run_ndim;
+          if (run_ndim > 1) {
+            // The order of the loops only matters to kernels that cannot run in parallel
+            if (parallel) {
+              reorder_by_strides(run_ndim, size.get(), stride.get_all());
+            }
+            ndim = coalesce_dimensions(run_ndim, size.get(), N + 1, stride.get_all());
+          }
+
+          // The two innermost dimensions are walked in tiles when they are transposed between the operands
+          intptr_t tiled_dim = -1;
+          if (parallel && ndim > 1 && is_transposed(stride.get_all(), ndim - 2, ndim - 1) &&
+              size[ndim - 2] >= tiled_elwise_kernel<N>::tile_size &&
+              size[ndim - 1] >= tiled_elwise_kernel<N>::tile_size) {
+            tiled_dim = ndim - 2;
+          }
+
+          // Instantiates the kernels of the dimensions from ``begin`` on, then the child
+          auto instantiate_dims = [&](intptr_t begin, kernel_request_t begin_kernreq) {
+            intptr_t nkernels = begin;
+            for (intptr_t j = begin; j < ndim; ++j, ++nkernels) {
+              kernel_request_t kr =
+                  (j == begin) ? begin_kernreq : static_cast<kernel_request_t>(kernel_request_strided);
+              std::array<intptr_t, N> src_stride;
+              for (size_t i = 0; i < N; ++i) {
+                src_stride[i] = stride.get(i + 1, j);
+              }
+
+              if (j == tiled_dim) {
+                std::array<intptr_t, N> src_inner_stride;
+                for (size_t i = 0; i < N; ++i) {
+                  src_inner_stride[i] = stride.get(i + 1, j + 1);
+                }
+                kb.emplace_back<tiled_elwise_kernel<N>>(kr, size[j], size[j + 1], stride.get(0, j),
+                                                        stride.get(0, j + 1), src_stride.data(),
+                                                        src_inner_stride.data());
+                ++j;
+              } else {
+                kb.emplace_back<elwise_kernel<fixed_dim_id, fixed_dim_id, TraitsType, N>>(kr, data, size[j],
+                                                                                          stride.get(0, j),
+                                                                                          src_stride.data());
+              }
+            }
+
+            // Skip the dimensions that were merged into others
+            for (; nkernels < run_ndim; ++nkernels) {
+              kb.pass();
+            }
+
+            kb(kernel_request_strided, TraitsType::child_data(data), child_dst_arrmeta, N, child_src_arrmeta.data());
+          };
+
+          // Only the outermost dimension is split over threads, the inner ones are requested as strided
+          const eval::eval_context &ectx = eval::default_eval_context;
+          size_t outer_size = size[0];
+          if (parallel && kernreq != kernel_request_strided && ectx.nthreads != 1 && !in_parallel_region() &&
+              outer_size >= 2 * ectx.grain_size) {
+            size_t nthreads = (ectx.nthreads == 0) ? hardware_concurrency() : ectx.nthreads;
+            nthreads = std::min(nthreads, outer_size / std::max(ectx.grain_size, static_cast<size_t>(1)));
+
+            std::array<intptr_t, N> src_stride;
+            for (size_t i = 0; i < N; ++i) {
+              src_stride[i] = stride.get(i + 1, 0);
+            }
+
+            intptr_t root_ckb_offset = kb.size();
+            kb.emplace_back<parallel_elwise_kernel<N>>(kernreq, size[0], stride.get(0, 0), src_stride.data(),
+                                                       nthreads, ectx.grain_size);
+
+            // The outermost dimension can't be both split and tiled
+            if (tiled_dim == 0) {
+              tiled_dim = -1;
+            }
+
+            // Every worker gets its own instance of the child kernel
+            call_node *child_call = kb.get_call();
+            for (size_t i = 0; i < nthreads; ++i) {
+              intptr_t child_offset = kb.size() - root_ckb_offset;
+              kb.rewind(child_call);
+              instantiate_dims(1, kernel_request_strided);
+              kb.get_at<parallel_elwise_kernel<N>>(root_ckb_offset)->m_child_offset.push_back(child_offset);
+            }
+            return;
+          }
 
-          kb(kernel_request_strided, TraitsType::child_data(data), child_dst_arrmeta, N, child_src_arrmeta.data());
+          instantiate_dims(0, kernreq);
         });
       }
 
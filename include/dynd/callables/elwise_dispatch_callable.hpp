@@ -26,6 +26,7 @@ namespace nd {
         bool state;
         size_t ndim;
         bool first;
+        std::shared_ptr<elwise_fixed_run> fixed_run;
       };
 
       elwise_dispatch_callable() : base_callable(ndt::type()) {}
@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/kernels/fused_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A callable for a chain of scalar callables, which is instantiated as a
+     * single ``fused_kernel``. The arguments of step ``i`` are the slots
+     * ``arg_slot[arg_begin[i]]`` up to ``arg_slot[arg_begin[i + 1]]``, and
+     * ``buffer_tp[i]`` is the (builtin) type of its result for all but the last
+     * step. Lifting it with ``elwise`` evaluates the whole chain in one pass.
+     */
+    class fused_callable : public base_callable {
+      std::vector<callable> m_children;
+      std::vector<intptr_t> m_arg_slot;
+      std::vector<size_t> m_arg_begin;
+      std::vector<ndt::type> m_buffer_tp;
+
+    public:
+      fused_callable(const ndt::type &tp, const std::vector<callable> &children, const std::vector<intptr_t> &arg_slot,
+                     const std::vector<size_t> &arg_begin, const std::vector<ndt::type> &buffer_tp)
+          : base_callable(tp), m_children(children), m_arg_slot(arg_slot), m_arg_begin(arg_begin),
+            m_buffer_tp(buffer_tp) {}
+
+      ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                        const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd, const array *kwds,
+                        const std::map<std::string, ndt::type> &tp_vars) {
+        std::vector<intptr_t> buffer_size;
+        for (const ndt::type &tp : m_buffer_tp) {
+          buffer_size.push_back(tp.get_data_size());
+        }
+
+        cg.emplace_back([arg_slot = m_arg_slot, arg_begin = m_arg_begin, buffer_size](
+            kernel_builder & kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+            size_t nsrc, const char *const *src_arrmeta) {
+          intptr_t root_ckb_offset = kb.size();
+          kb.emplace_back<fused_kernel>(kernreq, nsrc, arg_slot, arg_begin, buffer_size);
+
+          // The buffers have builtin types, so they have no arrmeta
+          std::vector<const char *> child_src_arrmeta(arg_slot.size());
+          for (size_t j = 0; j < arg_slot.size(); ++j) {
+            child_src_arrmeta[j] = (static_cast<size_t>(arg_slot[j]) < nsrc) ? src_arrmeta[arg_slot[j]] : nullptr;
+          }
+
+          size_t nsteps = arg_begin.size() - 1;
+          for (size_t i = 0; i < nsteps; ++i) {
+            intptr_t child_offset = kb.size() - root_ckb_offset;
+            kb(kernel_request_strided, nullptr, (i + 1 < nsteps) ? nullptr : dst_arrmeta,
+               arg_begin[i + 1] - arg_begin[i], child_src_arrmeta.data() + arg_begin[i]);
+            kb.get_at<fused_kernel>(root_ckb_offset)->m_child_offset.push_back(child_offset);
+          }
+        });
+
+        std::vector<ndt::type> slot_tp(src_tp, src_tp + nsrc);
+        slot_tp.insert(slot_tp.end(), m_buffer_tp.begin(), m_buffer_tp.end());
+
+        ndt::type ret_tp;
+        for (size_t i = 0; i < m_children.size(); ++i) {
+          std::vector<ndt::type> child_src_tp;
+          for (size_t j = m_arg_begin[i]; j < m_arg_begin[i + 1]; ++j) {
+            child_src_tp.push_back(slot_tp[m_arg_slot[j]]);
+          }
+
+          ret_tp = m_children[i]->resolve(this, nullptr, cg, (i + 1 < m_children.size()) ? m_buffer_tp[i] : dst_tp,
+                                          child_src_tp.size(), child_src_tp.data(), nkwd, kwds, tp_vars);
+        }
+
+        return ret_tp;
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
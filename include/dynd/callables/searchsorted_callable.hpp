@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/comparison.hpp>
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/kernels/searchsorted_kernel.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * The insertion indices of the needles in the second argument into the
+   * sorted first argument, which keep it sorted, as ``int64``. The ``side``
+   * keyword, ``"left"`` by default or ``"right"``, picks the index before or
+   * after any values equal to a needle.
+   */
+  class searchsorted_callable : public base_callable {
+    typedef void (*emplace_typed_kernel_t)(kernel_builder &kb, kernel_request_t kernreq, intptr_t src0_size,
+                                           intptr_t src0_stride, intptr_t src1_size, intptr_t src1_stride,
+                                           intptr_t dst_stride, bool right, size_t nthreads);
+
+    template <typename T>
+    static void emplace_typed_kernel(kernel_builder &kb, kernel_request_t kernreq, intptr_t src0_size,
+                                     intptr_t src0_stride, intptr_t src1_size, intptr_t src1_stride,
+                                     intptr_t dst_stride, bool right, size_t nthreads) {
+      kb.emplace_back<typed_searchsorted_kernel<T>>(kernreq, src0_size, src0_stride, src1_size, src1_stride,
+                                                    dst_stride, right, nthreads);
+    }
+
+    /**
+     * Returns the function that emplaces a ``typed_searchsorted_kernel`` for
+     * builtin integers and floats, or nullptr for other types.
+     */
+    static emplace_typed_kernel_t get_emplace_typed_kernel(type_id_t id) {
+      switch (id) {
+      case int8_id:
+        return &emplace_typed_kernel<int8_t>;
+      case int16_id:
+        return &emplace_typed_kernel<int16_t>;
+      case int32_id:
+        return &emplace_typed_kernel<int32_t>;
+      case int64_id:
+        return &emplace_typed_kernel<int64_t>;
+      case uint8_id:
+        return &emplace_typed_kernel<uint8_t>;
+      case uint16_id:
+        return &emplace_typed_kernel<uint16_t>;
+      case uint32_id:
+        return &emplace_typed_kernel<uint32_t>;
+      case uint64_id:
+        return &emplace_typed_kernel<uint64_t>;
+      case float32_id:
+        return &emplace_typed_kernel<float>;
+      case float64_id:
+        return &emplace_typed_kernel<double>;
+      default:
+        return nullptr;
+      }
+    }
+
+    static bool get_right(const array &kwd) {
+      if (kwd.is_null() || kwd.is_na()) {
+        return false;
+      }
+
+      // A missing ``side`` is filled in as an NA ``?string``, which is stored
+      // as an empty string that ``is_na`` does not see. A ``side`` that is
+      // passed keeps its own type.
+      std::string side = kwd.as<std::string>();
+      if (kwd.get_type().get_id() == option_id && side.empty()) {
+        return false;
+      }
+
+      if (side == "left") {
+        return false;
+      } else if (side == "right") {
+        return true;
+      }
+
+      std::stringstream ss;
+      ss << "searchsorted: side must be \"left\" or \"right\", not \"" << side << "\"";
+      throw std::invalid_argument(ss.str());
+    }
+
+  public:
+    searchsorted_callable()
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::type("Fixed * int64"), {ndt::type("Fixed * Scalar"), ndt::type("Fixed * Scalar")},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<ndt::string_type>()), "side"}})) {}
+
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      const ndt::type &src1_element_tp = src_tp[1].extended<ndt::fixed_dim_type>()->get_element_type();
+      bool right = nkwd > 0 && get_right(kwds[0]);
+      ndt::type ret_tp = ndt::make_fixed_dim(src_tp[1].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(),
+                                             ndt::make_type<int64_t>());
+
+      emplace_typed_kernel_t emplace_typed =
+          src0_element_tp == src1_element_tp ? get_emplace_typed_kernel(src0_element_tp.get_id()) : nullptr;
+      if (emplace_typed != nullptr) {
+        cg.emplace_back([emplace_typed, right](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                               const char *dst_arrmeta, size_t DYND_UNUSED(nsrc),
+                                               const char *const *src_arrmeta) {
+          const eval::eval_context &ectx = eval::default_eval_context;
+          const fixed_dim_type_arrmeta *src0_arrmeta = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0]);
+          const fixed_dim_type_arrmeta *src1_arrmeta = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[1]);
+          emplace_typed(kb, kernreq, src0_arrmeta->dim_size, src0_arrmeta->stride, src1_arrmeta->dim_size,
+                        src1_arrmeta->stride, reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+                        right, (ectx.nthreads == 0) ? hardware_concurrency() : ectx.nthreads);
+        });
+
+        return ret_tp;
+      }
+
+      // Other types are compared with the less callable, with the haystack
+      // value first on the left side and the needle first on the right side
+      cg.emplace_back([right](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                              const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        const fixed_dim_type_arrmeta *src0_arrmeta = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0]);
+        const fixed_dim_type_arrmeta *src1_arrmeta = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[1]);
+        kb.emplace_back<searchsorted_kernel>(kernreq, src0_arrmeta->dim_size, src0_arrmeta->stride,
+                                             src1_arrmeta->dim_size, src1_arrmeta->stride,
+                                             reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride,
+                                             right);
+
+        kb(kernel_request_single, nullptr, nullptr, 2, nullptr);
+      });
+
+      ndt::type child_src_tp[2] = {src0_element_tp, src1_element_tp};
+      if (right) {
+        std::swap(child_src_tp[0], child_src_tp[1]);
+      }
+      less->resolve(this, nullptr, cg, ndt::make_type<bool1>(), 2, child_src_tp, 0, nullptr, tp_vars);
+
+      return ret_tp;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -7,12 +7,53 @@
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/comparison.hpp>
+#include <dynd/eval/eval_context.hpp>
 #include <dynd/kernels/sort_kernel.hpp>
 
 namespace dynd {
 namespace nd {
 
   class sort_callable : public base_callable {
+    typedef void (*emplace_typed_kernel_t)(kernel_builder &kb, kernel_request_t kernreq, intptr_t size,
+                                           intptr_t stride, size_t nthreads);
+
+    template <typename T>
+    static void emplace_typed_kernel(kernel_builder &kb, kernel_request_t kernreq, intptr_t size, intptr_t stride,
+                                     size_t nthreads) {
+      kb.emplace_back<typed_sort_kernel<T>>(kernreq, size, stride, nthreads);
+    }
+
+    /**
+     * Returns the function that emplaces a ``typed_sort_kernel`` for builtin
+     * integers and floats, or nullptr for other types.
+     */
+    static emplace_typed_kernel_t get_emplace_typed_kernel(type_id_t id) {
+      switch (id) {
+      case int8_id:
+        return &emplace_typed_kernel<int8_t>;
+      case int16_id:
+        return &emplace_typed_kernel<int16_t>;
+      case int32_id:
+        return &emplace_typed_kernel<int32_t>;
+      case int64_id:
+        return &emplace_typed_kernel<int64_t>;
+      case uint8_id:
+        return &emplace_typed_kernel<uint8_t>;
+      case uint16_id:
+        return &emplace_typed_kernel<uint16_t>;
+      case uint32_id:
+        return &emplace_typed_kernel<uint32_t>;
+      case uint64_id:
+        return &emplace_typed_kernel<uint64_t>;
+      case float32_id:
+        return &emplace_typed_kernel<float>;
+      case float64_id:
+        return &emplace_typed_kernel<double>;
+      default:
+        return nullptr;
+      }
+    }
+
   public:
     sort_callable()
         : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
@@ -22,6 +63,22 @@ namespace nd {
                       size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
                       const std::map<std::string, ndt::type> &tp_vars) {
       const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+
+      emplace_typed_kernel_t emplace_typed = get_emplace_typed_kernel(src0_element_tp.get_id());
+      if (emplace_typed != nullptr) {
+        cg.emplace_back([emplace_typed](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                        const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
+                                        const char *const *src_arrmeta) {
+          const eval::eval_context &ectx = eval::default_eval_context;
+          emplace_typed(kb, kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+                        reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
+                        (ectx.nthreads == 0) ? hardware_concurrency() : ectx.nthreads);
+        });
+
+        return dst_tp;
+      }
+
+      // Other types are sorted with the less callable as the comparison
       size_t src0_element_data_size = src0_element_tp.get_data_size();
       cg.emplace_back([src0_element_data_size](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
                                                const char *DYND_UNUSED(dst_arrmeta), size_t DYND_UNUSED(nsrc),
@@ -7,40 +7,136 @@
 
 #include <dynd/callables/base_callable.hpp>
 #include <dynd/kernels/unique_kernel.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/struct_type.hpp>
 
 namespace dynd {
 namespace nd {
 
+  /**
+   * The distinct values of a one-dimensional array, in the order of their
+   * first occurrence, as a ``var`` dimension. With ``return_counts`` or
+   * ``return_inverse`` set, the result is a struct that also has the number
+   * of occurrences of each value as ``counts``, and the index into the values
+   * of every element as ``inverse``.
+   */
   class unique_callable : public base_callable {
+    typedef void (*emplace_kernel_t)(kernel_builder &kb, kernel_request_t kernreq, intptr_t size, intptr_t src_stride,
+                                     const char *values_arrmeta, intptr_t values_offset, const char *counts_arrmeta,
+                                     intptr_t counts_offset, intptr_t inverse_stride, intptr_t inverse_offset);
+
+    template <typename T>
+    static void emplace_kernel(kernel_builder &kb, kernel_request_t kernreq, intptr_t size, intptr_t src_stride,
+                               const char *values_arrmeta, intptr_t values_offset, const char *counts_arrmeta,
+                               intptr_t counts_offset, intptr_t inverse_stride, intptr_t inverse_offset) {
+      kb.emplace_back<unique_kernel<T>>(kernreq, size, src_stride, values_arrmeta, values_offset, counts_arrmeta,
+                                        counts_offset, inverse_stride, inverse_offset);
+    }
+
+    static emplace_kernel_t get_emplace_kernel(const ndt::type &tp) {
+      switch (tp.get_id()) {
+      // bool1 values are the bytes 0 and 1
+      case bool_id:
+      case uint8_id:
+        return &emplace_kernel<uint8_t>;
+      case int8_id:
+        return &emplace_kernel<int8_t>;
+      case int16_id:
+        return &emplace_kernel<int16_t>;
+      case int32_id:
+        return &emplace_kernel<int32_t>;
+      case int64_id:
+        return &emplace_kernel<int64_t>;
+      case uint16_id:
+        return &emplace_kernel<uint16_t>;
+      case uint32_id:
+        return &emplace_kernel<uint32_t>;
+      case uint64_id:
+        return &emplace_kernel<uint64_t>;
+      case float32_id:
+        return &emplace_kernel<float>;
+      case float64_id:
+        return &emplace_kernel<double>;
+      case string_id:
+        return &emplace_kernel<string>;
+      default:
+        std::stringstream ss;
+        ss << "unique is not implemented for values of type " << tp;
+        throw type_error(ss.str());
+      }
+    }
+
+    static bool get_flag(const array &kwd) { return !kwd.is_null() && !kwd.is_na() && kwd.as<bool>(); }
+
   public:
     unique_callable()
-        : base_callable(ndt::make_type<ndt::callable_type>(ndt::make_type<void>(), {ndt::type("Fixed * Scalar")})) {}
+        : base_callable(ndt::make_type<ndt::callable_type>(
+              ndt::type("Any"), {ndt::type("Fixed * Scalar")},
+              {{ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "return_counts"},
+               {ndt::make_type<ndt::option_type>(ndt::make_type<bool1>()), "return_inverse"}})) {}
 
-    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &DYND_UNUSED(cg),
-                      const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
-                      size_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                      const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
-      return dst_tp;
-    }
+    ndt::type resolve(base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), call_graph &cg,
+                      const ndt::type &DYND_UNUSED(dst_tp), size_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                      size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+      const ndt::fixed_dim_type *src0_tp = src_tp[0].extended<ndt::fixed_dim_type>();
+      const ndt::type &src0_element_tp = src0_tp->get_element_type();
+      emplace_kernel_t emplace = get_emplace_kernel(src0_element_tp);
+
+      bool counts = nkwd > 0 && get_flag(kwds[0]);
+      bool inverse = nkwd > 1 && get_flag(kwds[1]);
+
+      ndt::type values_tp = ndt::make_type<ndt::var_dim_type>(src0_element_tp);
+      if (!counts && !inverse) {
+        cg.emplace_back([emplace](kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data),
+                                  const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+          const fixed_dim_type_arrmeta *src0_arrmeta = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0]);
+          emplace(kb, kernreq, src0_arrmeta->dim_size, src0_arrmeta->stride, dst_arrmeta, 0, nullptr, 0, 0, -1);
+        });
 
-    /*
-        void instantiate(call_node *&node, char *data, kernel_builder *ckb, const ndt::type &DYND_UNUSED(dst_tp),
-                         const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
-                         const char *const *src_arrmeta, kernel_request_t kernreq, intptr_t nkwd, const nd::array *kwds,
-                         const std::map<std::string, ndt::type> &tp_vars) {
-          const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
-          ckb->emplace_back<unique_kernel>(
-              kernreq, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-              reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride,
-       src0_element_tp.get_data_size());
-          node = next(node);
-
-          const ndt::type equal_src_tp[2] = {src0_element_tp, src0_element_tp};
-          equal->instantiate(node, data, ckb, ndt::make_type<bool1>(), NULL, 2, equal_src_tp, NULL,
-       kernel_request_single,
-                             nkwd, kwds, tp_vars);
+        return values_tp;
+      }
+
+      std::vector<std::string> names{"values"};
+      std::vector<ndt::type> types{values_tp};
+      if (counts) {
+        names.push_back("counts");
+        types.push_back(ndt::make_type<ndt::var_dim_type>(ndt::make_type<int64_t>()));
+      }
+      if (inverse) {
+        names.push_back("inverse");
+        types.push_back(ndt::make_fixed_dim(src0_tp->get_fixed_dim_size(), ndt::make_type<int64_t>()));
+      }
+      ndt::type ret_tp = ndt::make_type<ndt::struct_type>(names, types);
+
+      std::vector<uintptr_t> arrmeta_offsets = ret_tp.extended<ndt::struct_type>()->get_arrmeta_offsets();
+      cg.emplace_back([emplace, counts, inverse, arrmeta_offsets](
+          kernel_builder &kb, kernel_request_t kernreq, char *DYND_UNUSED(data), const char *dst_arrmeta,
+          size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+        // A struct's arrmeta starts with the data offsets of its fields
+        const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(dst_arrmeta);
+        const fixed_dim_type_arrmeta *src0_arrmeta = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0]);
+
+        const char *counts_arrmeta = nullptr;
+        intptr_t counts_offset = 0;
+        if (counts) {
+          counts_arrmeta = dst_arrmeta + arrmeta_offsets[1];
+          counts_offset = data_offsets[1];
+        }
+
+        intptr_t inverse_stride = 0;
+        intptr_t inverse_offset = -1;
+        if (inverse) {
+          size_t i = counts ? 2 : 1;
+          inverse_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta + arrmeta_offsets[i])->stride;
+          inverse_offset = data_offsets[i];
         }
-    */
+
+        emplace(kb, kernreq, src0_arrmeta->dim_size, src0_arrmeta->stride, dst_arrmeta + arrmeta_offsets[0],
+                data_offsets[0], counts_arrmeta, counts_offset, inverse_stride, inverse_offset);
+      });
+
+      return ret_tp;
+    }
   };
 
 } // namespace dynd::nd
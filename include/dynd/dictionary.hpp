@@ -0,0 +1,57 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <initializer_list>
+#include <utility>
+
+#include <dynd/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Dictionary-encodes a one-dimensional array of strings. The result is a
+   * struct ``{codes: N * uint32, dictionary: M * string}`` that holds each
+   * distinct string once in ``dictionary``, in the order of its first
+   * occurrence, and the index of every element's string in ``codes``.
+   *
+   * A column with few distinct values repeated many times takes four bytes
+   * per element instead of a string each, and the functions below run string
+   * operations once per distinct value instead of once per element.
+   */
+  DYND_API array dictionary_encode(const array &values);
+
+  /**
+   * Expands a dictionary-encoded array back to an ``N * T`` array of its
+   * values.
+   */
+  DYND_API array dictionary_decode(const array &encoded);
+
+  /**
+   * Calls ``f`` on the dictionary of ``encoded``, followed by ``args`` and
+   * ``kwds``, and expands the result with the codes. For an elementwise
+   * ``f`` this is the same as calling it on the decoded array, e.g.
+   *
+   *     nd::dictionary_map(nd::string_contains, encoded, {"needle"})
+   *
+   * but ``f`` sees each distinct value only once. The result of ``f`` must
+   * have one element per dictionary entry, of a fixed-layout type or
+   * ``string``.
+   */
+  DYND_API array dictionary_map(const callable &f, const array &encoded, std::initializer_list<array> args = {},
+                                std::initializer_list<std::pair<const char *, array>> kwds = {});
+
+  /**
+   * Like ``dictionary_map``, but keeps the result encoded with the same
+   * codes, i.e. replaces the dictionary with the result of ``f``. The values
+   * of the new dictionary need not be distinct.
+   */
+  DYND_API array dictionary_transform(const callable &f, const array &encoded, std::initializer_list<array> args = {},
+                                      std::initializer_list<std::pair<const char *, array>> kwds = {});
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -5,10 +5,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
-// #include <sparsehash/dense_hash_map>
-
 #include <dynd/type_registry.hpp>
 
 namespace dynd {
@@ -91,6 +90,86 @@ namespace detail {
     }
   }
 
+  /**
+   * A fixed-size, open-addressing memo of previous dispatcher lookups, keyed on
+   * a tuple of type ids. Every slot packs the ids of its key into the high 32
+   * bits and the index of the result plus one into the low 32 bits, so that a
+   * slot is claimed with a single compare-and-swap and zero means empty. This
+   * makes concurrent lookups and memoizations safe without a lock.
+   *
+   * If a key cannot be placed within a few probes it is simply not memoized.
+   */
+  template <size_t N>
+  class dispatch_memo {
+    static_assert(dim_fragment_id < 256, "type ids must fit in 8 bits to be packed into a dispatch key");
+
+    static const size_t capacity = (N == 1) ? 64 : 1024;
+    static const size_t max_probes = 16;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+
+  public:
+    static const bool enabled = N <= 4;
+
+    dispatch_memo() : m_slots(new std::atomic<uint64_t>[capacity]) { clear(); }
+
+    static uint64_t key(const std::array<type_id_t, N> &ids) {
+      uint64_t res = 0;
+      for (size_t i = 0; i < N; ++i) {
+        res = (res << 8) | static_cast<uint64_t>(ids[i]);
+      }
+
+      return res;
+    }
+
+    static size_t hash(uint64_t key) {
+      // Fibonacci hashing spreads the densely packed ids over the table
+      return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 40) & (capacity - 1);
+    }
+
+    /**
+     * Returns the index memoized for the key, or -1 if there is none.
+     */
+    intptr_t find(uint64_t key) const {
+      size_t i = hash(key);
+      for (size_t probe = 0; probe < max_probes; ++probe, i = (i + 1) & (capacity - 1)) {
+        uint64_t slot = m_slots[i].load(std::memory_order_acquire);
+        if (slot == 0) {
+          return -1;
+        }
+
+        if ((slot >> 32) == key) {
+          return static_cast<intptr_t>(slot & 0xFFFFFFFF) - 1;
+        }
+      }
+
+      return -1;
+    }
+
+    void insert(uint64_t key, size_t index) {
+      uint64_t value = (key << 32) | (static_cast<uint64_t>(index) + 1);
+
+      size_t i = hash(key);
+      for (size_t probe = 0; probe < max_probes; ++probe, i = (i + 1) & (capacity - 1)) {
+        uint64_t expected = 0;
+        if (m_slots[i].compare_exchange_strong(expected, value, std::memory_order_acq_rel)) {
+          return;
+        }
+
+        // Either another thread memoized the same key, or the slot belongs to another key
+        if ((expected >> 32) == key) {
+          return;
+        }
+      }
+    }
+
+    void clear() {
+      for (size_t i = 0; i < capacity; ++i) {
+        m_slots[i].store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
 } // namespace dynd::detail
 
 template <typename VertexIterator, typename EdgeIterator, typename Iterator>
@@ -130,24 +209,34 @@ inline std::ostream &print_ids(std::ostream &o, size_t nids, const ndt::type *tp
   return o;
 }
 
+/**
+ * Selects the most specific child whose dispatch signature matches a call.
+ *
+ * Lookups in which every dispatch type is builtin are memoized on their type
+ * ids, as those fully determine the result. The memo is cleared by ``assign``
+ * and ``insert``, which must not run concurrently with lookups, whereas
+ * lookups may run concurrently with each other.
+ */
 template <size_t N, typename T>
 class dispatcher {
-  typedef std::map<size_t, T> Map;
-
 public:
   typedef T value_type;
 
-  typedef Map map_type;
-  //  typedef google::dense_hash_map<size_t, value_type> map_type;
+  typedef detail::dispatch_memo<N> map_type;
 
   typedef typename std::vector<T>::iterator iterator;
   typedef typename std::vector<T>::const_iterator const_iterator;
 
 private:
   std::vector<T> m_children;
-  //  map_type m_map;
+  std::vector<std::array<ndt::type, N>> m_signatures;
+  map_type m_map;
   dispatch_t m_dispatch;
 
+  std::array<ndt::type, N> signature(const T &child) const {
+    return as_array<N>(m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data()));
+  }
+
   static size_t hash_combine(size_t seed, type_id_t id) { return seed ^ (id + (seed << 6) + (seed >> 2)); }
 
   template <typename... IDTypes>
@@ -167,38 +256,45 @@ private:
 public:
   dispatcher(dispatch_t dispatch) : m_dispatch(dispatch) {}
 
-  dispatcher(const dispatcher &other) : m_children(other.m_children), m_dispatch(other.m_dispatch) {}
+  dispatcher(const dispatcher &other)
+      : m_children(other.m_children), m_signatures(other.m_signatures), m_dispatch(other.m_dispatch) {}
 
   template <typename Iterator>
   dispatcher(dispatch_t dispatch, Iterator begin, Iterator end) : m_dispatch(dispatch) {
-    //    m_map.set_empty_key(uninitialized_id);
-
     assign(begin, end);
   }
 
   dispatcher(dispatch_t dispatch, std::initializer_list<T> pairs) : dispatcher(dispatch, pairs.begin(), pairs.end()) {}
 
+  dispatcher &operator=(const dispatcher &other) {
+    m_children = other.m_children;
+    m_signatures = other.m_signatures;
+    m_dispatch = other.m_dispatch;
+    m_map.clear();
+
+    return *this;
+  }
+
   template <typename Iterator>
   void assign(Iterator begin, Iterator end) {
     m_children.resize(end - begin);
 
+    std::vector<std::array<ndt::type, N>> tps(m_children.size());
+    for (size_t i = 0; i < tps.size(); ++i) {
+      tps[i] = signature(begin[i]);
+    }
+
     std::vector<std::vector<size_t>> edges(m_children.size());
     for (size_t i = 0; i < edges.size(); ++i) {
-      const auto &f_i = begin[i];
-      std::array<ndt::type, N> tp_i =
-          as_array<N>(m_dispatch(f_i->get_ret_type(), f_i->get_narg(), f_i->get_arg_types().data()));
+      const std::array<ndt::type, N> &tp_i = tps[i];
 
       for (size_t j = i + 1; j < edges.size(); ++j) {
-        const auto &f_j = begin[j];
-        std::array<ndt::type, N> tp_j =
-            as_array<N>(m_dispatch(f_j->get_ret_type(), f_j->get_narg(), f_j->get_arg_types().data()));
+        const std::array<ndt::type, N> &tp_j = tps[j];
 
         if (ambiguous(tp_i, tp_j)) {
           bool ok = false;
           for (size_t k = 0; k < edges.size(); ++k) {
-            const auto &f_k = begin[k];
-            std::array<ndt::type, N> tp_k =
-                as_array<N>(m_dispatch(f_k->get_ret_type(), f_k->get_narg(), f_k->get_arg_types().data()));
+            const std::array<ndt::type, N> &tp_k = tps[k];
 
             if (supercedes(tp_k, tp_i) && supercedes(tp_k, tp_j)) {
               ok = true;
@@ -225,7 +321,12 @@ public:
 
     topological_sort(begin, end, edges, m_children.begin());
 
-    //    m_map.clear();
+    m_signatures.resize(m_children.size());
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      m_signatures[i] = signature(m_children[i]);
+    }
+
+    m_map.clear();
   }
 
   void assign(std::initializer_list<T> pairs) { assign(pairs.begin(), pairs.end()); }
@@ -250,31 +351,37 @@ public:
   const_iterator end() const { return m_children.end(); }
   const_iterator cend() const { return m_children.cend(); }
 
+  size_t size() const { return m_children.size(); }
+
   const value_type &operator()(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp) {
     std::vector<ndt::type> vector_tps = m_dispatch(dst_tp, nsrc, src_tp);
     std::array<ndt::type, N> tps;
 
+    bool builtin = map_type::enabled;
     std::array<type_id_t, N> ids;
     for (size_t i = 0; i < N; ++i) {
       tps[i] = vector_tps[i];
       ids[i] = tps[i].get_id();
+      builtin = builtin && tps[i].is_builtin();
     }
 
-    //    size_t key = hash(ids);
+    uint64_t key = 0;
+    if (builtin) {
+      key = map_type::key(ids);
 
-    /*
-        const auto &it = m_map.find(key);
-        if (it != m_map.end()) {
-          return it->second;
-        }
-    */
+      intptr_t i = m_map.find(key);
+      if (i != -1) {
+        return m_children[i];
+      }
+    }
 
-    for (const T &child : m_children) {
-      std::array<ndt::type, N> other_tps =
-          as_array<N>(m_dispatch(child->get_ret_type(), child->get_narg(), child->get_arg_types().data()));
+    for (size_t i = 0; i < m_children.size(); ++i) {
+      if (supercedes(tps, m_signatures[i])) {
+        if (builtin) {
+          m_map.insert(key, i);
+        }
 
-      if (supercedes(tps, other_tps)) {
-        return child;
+        return m_children[i];
       }
     }
 
@@ -13,8 +13,13 @@ namespace eval {
   struct DYNDT_API eval_context {
     // Default error mode for computations
     assign_error_mode errmode;
+    // Maximum number of threads for the outermost loop of elementwise
+    // kernels, where 1 keeps them serial and 0 means one thread per core
+    size_t nthreads;
+    // Minimum number of outermost loop iterations given to a thread
+    size_t grain_size;
 
-    eval_context() : errmode(assign_error_fractional) {}
+    eval_context() : errmode(assign_error_fractional), nthreads(1), grain_size(1024) {}
   };
 
   extern DYNDT_API eval_context default_eval_context;
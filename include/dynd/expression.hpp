@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <dynd/callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A deferred elementwise expression. Arithmetic on expressions records the
+   * operations instead of running them, and ``eval`` runs the whole graph as
+   * one fused kernel, so that e.g. ``lazy(a) + lazy(b) * c`` makes a single
+   * pass over memory without a temporary array for ``b * c``.
+   *
+   * The intermediate results are kept in small per-block buffers, which
+   * requires them to have builtin types. Graphs that do not qualify are
+   * evaluated one operation at a time instead, with the same result.
+   */
+  class DYND_API expression {
+    struct node {
+      array value;
+      callable func;
+      std::vector<expression> args;
+    };
+
+    std::shared_ptr<const node> m_node;
+
+  public:
+    /**
+     * Constructs an expression that is just the array ``value``.
+     */
+    expression(const array &value);
+
+    /**
+     * Constructs an expression that applies the elementwise callable ``func``
+     * to the results of ``args``.
+     */
+    expression(const callable &func, std::initializer_list<expression> args);
+
+    expression(const callable &func, const std::vector<expression> &args);
+
+    bool is_leaf() const { return m_node->func.is_null(); }
+
+    /**
+     * Evaluates the expression into a new array.
+     */
+    array eval() const;
+
+  private:
+    intptr_t flatten(std::vector<array> &leaves, std::vector<callable> &children,
+                     std::vector<std::vector<intptr_t>> &child_args) const;
+
+    array eval_unfused() const;
+  };
+
+  /**
+   * Starts a deferred expression with the array ``a``.
+   */
+  inline expression lazy(const array &a) { return expression(a); }
+
+  DYND_API expression operator-(const expression &a0);
+
+  DYND_API expression operator+(const expression &op0, const expression &op1);
+  DYND_API expression operator-(const expression &op0, const expression &op1);
+  DYND_API expression operator*(const expression &op0, const expression &op1);
+  DYND_API expression operator/(const expression &op0, const expression &op1);
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -158,8 +158,13 @@ namespace nd {
     /**
      * Lifts the provided callable, broadcasting it as necessary to execute
      * across the additional dimensions in the ``lifted_types`` array.
+     *
+     * If ``properties`` includes ``left_associative``, the innermost reduced
+     * dimension may be split into chunks that are reduced on separate threads
+     * (see ``eval::eval_context::nthreads``). The partial results are combined
+     * pairwise in chunk order, so the result only depends on the thread count.
      */
-    DYND_API callable reduction(const callable &identity, const callable &child);
+    DYND_API callable reduction(const callable &identity, const callable &child, callable_property properties = none);
 
     DYND_API callable where(const callable &child);
 
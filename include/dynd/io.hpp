@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <iostream>
+#include <string>
+
 #include <dynd/callable.hpp>
 
 namespace dynd {
@@ -12,5 +15,42 @@ namespace nd {
 
   extern DYND_API callable serialize;
 
+  /**
+   * Writes the array in the dynd binary format, which is self-describing. It
+   * is a small header, the datashape of the array's type, and then the data
+   * at a 64-byte aligned offset. The data is laid out as the default arrmeta
+   * of the type describes it, i.e. C-contiguous with packed structs, so the
+   * arrmeta is not stored.
+   *
+   * Strings, bytes and the elements of var_dims are stored after the value
+   * that refers to them, each var_dim also 64-byte aligned. The value holds
+   * their offset from the start of the data and their size in place of a
+   * pointer.
+   *
+   * The data is in native byte order. Reading it on a machine with the other
+   * byte order fails.
+   */
+  DYND_API void write_binary(std::ostream &o, const array &a);
+
+  /**
+   * Writes the array to a file in the dynd binary format, replacing the file.
+   */
+  DYND_API void save_binary(const std::string &filename, const array &a);
+
+  /**
+   * Reads an array in the dynd binary format from [begin, end). The result
+   * is a copy, so the memory does not need to outlive it.
+   */
+  DYND_API array read_binary(const char *begin, const char *end);
+
+  /**
+   * Reads an array from a file in the dynd binary format. The file is memory
+   * mapped and, if the type has a fixed layout (no strings, bytes or var_dims),
+   * the result is an immutable view of the mapped data, so nothing is copied
+   * and only the pages that are accessed are read. Otherwise the data is
+   * copied out of the mapping.
+   */
+  DYND_API array load_binary(const std::string &filename);
+
 } // namespace dynd::nd
 } // namespace dynd
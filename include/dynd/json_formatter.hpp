@@ -5,10 +5,111 @@
 
 #pragma once
 
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <dynd/array.hpp>
 
 namespace dynd {
 
+/**
+ * A growable output buffer that ``format_json`` appends to. Its memory is
+ * kept when it is cleared, and so are the field name prefixes of the struct
+ * types it has formatted, so formatting many arrays through one buffer
+ * allocates almost nothing after the first.
+ *
+ * A buffer constructed with a file descriptor writes its contents to it
+ * whenever they reach ``flush_size`` bytes, and when it is flushed or
+ * destroyed. Errors from the destructor are lost, so call ``flush`` first to
+ * see them.
+ */
+class DYND_API json_buffer {
+  char *m_begin, *m_end, *m_capacity_end;
+  int m_fd;
+  size_t m_flush_size;
+  // The strings written before every field of a struct type, keyed on the
+  // type, which the entry keeps alive
+  std::map<const ndt::base_type *, std::pair<ndt::type, std::vector<std::string>>> m_field_prefixes;
+
+  void grow(size_t added_size);
+
+public:
+  json_buffer();
+
+  explicit json_buffer(int fd, size_t flush_size = 1 << 16);
+
+  // non-copyable
+  json_buffer(const json_buffer &) = delete;
+
+  ~json_buffer();
+
+  json_buffer &operator=(const json_buffer &) = delete;
+
+  const char *data() const { return m_begin; }
+
+  size_t size() const { return m_end - m_begin; }
+
+  std::string str() const { return std::string(m_begin, m_end); }
+
+  /**
+   * Empties the buffer, keeping its memory.
+   */
+  void clear() { m_end = m_begin; }
+
+  /**
+   * Writes the contents to the file descriptor and empties the buffer. Does
+   * nothing for a buffer without a file descriptor.
+   */
+  void flush();
+
+  /**
+   * Makes room for ``added_size`` more bytes, flushing if the buffer writes
+   * to a file descriptor.
+   */
+  void reserve(size_t added_size) {
+    if (static_cast<size_t>(m_capacity_end - m_end) < added_size) {
+      grow(added_size);
+    }
+  }
+
+  void write(char c) {
+    reserve(1);
+    *m_end++ = c;
+  }
+
+  template <int N>
+  void write(const char(&str)[N]) {
+    write(str, str + N - 1);
+  }
+
+  void write(const std::string &s) { write(s.data(), s.data() + s.size()); }
+
+  void write(const char *begin, const char *end) {
+    reserve(end - begin);
+    memcpy(m_end, begin, end - begin);
+    m_end += end - begin;
+  }
+
+  /**
+   * Returns the strings that go in front of every field when a struct of
+   * type ``tp`` is formatted as an object, i.e. the opening brace or a comma,
+   * the quoted and escaped name and a colon. They are computed once per type.
+   */
+  const std::vector<std::string> &get_field_prefixes(const ndt::type &tp);
+
+  /**
+   * Forgets the field prefixes if there are more than ``max_types`` struct
+   * types cached.
+   */
+  void clear_field_prefixes(size_t max_types = 0) {
+    if (m_field_prefixes.size() > max_types) {
+      m_field_prefixes.clear();
+    }
+  }
+};
+
 /**
  * Formats the nd::array as JSON.
  *
@@ -18,4 +119,9 @@ namespace dynd {
  */
 DYND_API nd::array format_json(const nd::array &a, bool struct_as_list = false);
 
+/**
+ * Formats the nd::array as JSON, appending it to ``out``.
+ */
+DYND_API void format_json(json_buffer &out, const nd::array &a, bool struct_as_list = false);
+
 } // namespace dynd
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace json {
+
+  /**
+   * The positions of the structural characters of a JSON text, i.e. the
+   * brackets, braces, colons and commas outside of strings, together with
+   * the quotes that open and close every string. An opening quote is always
+   * immediately followed by its closing quote in the index.
+   *
+   * The characters are classified 64 bytes at a time with the widest
+   * instruction set that ``get_simd_isa`` allows, and the quotes and escapes
+   * are resolved with bit operations on those masks, so the text is only
+   * scanned once. Every bracket and brace additionally records the entry of
+   * its match and the number of items between them, which lets a parser size
+   * a dimension before it reads it and skip over a value without scanning it.
+   *
+   * Building the index only checks that strings are closed and brackets
+   * balance. Everything else about the text is left to the parser.
+   */
+  class DYND_API structural_index {
+    const char *m_begin;
+    std::vector<uint32_t> m_positions;
+    std::vector<uint32_t> m_matches;
+    std::vector<uint32_t> m_counts;
+
+    bool build_structure();
+
+  public:
+    /**
+     * The largest text that can be indexed, which is limited by the 32-bit
+     * positions.
+     */
+    static const size_t max_size = 0xffffffffu;
+
+    structural_index() : m_begin(nullptr) {}
+
+    /**
+     * Indexes the JSON text in [begin, end), returning false if the text is
+     * too large, a string is not closed or the brackets do not balance.
+     */
+    bool build(const char *begin, const char *end);
+
+    /** The number of entries in the index */
+    size_t size() const { return m_positions.size(); }
+
+    /** The character of entry ``i`` */
+    const char *get(size_t i) const { return m_begin + m_positions[i]; }
+
+    /** The entry of the bracket or brace that closes the one at entry ``i`` */
+    size_t get_match(size_t i) const { return m_matches[i]; }
+
+    /**
+     * The number of items, i.e. elements or fields, between the bracket or
+     * brace at entry ``i`` and its match.
+     */
+    size_t get_count(size_t i) const { return m_counts[i]; }
+  };
+
+} // namespace dynd::json
+} // namespace dynd
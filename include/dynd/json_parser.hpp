@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <functional>
+#include <iostream>
+
 #include <dynd/array.hpp>
 
 namespace dynd {
@@ -65,6 +68,16 @@ DYND_API nd::array parse_json(const ndt::type &tp, const char *json_begin, const
  */
 DYND_API void parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx);
 
+/**
+ * Parses the JSON into an uninitialized dynd array with the two pass parser,
+ * which first builds a structural index of the text with SIMD. Returns false
+ * if it could not, e.g. without SIMD, for a short text or for a type it does
+ * not handle, and ``out`` then has to be parsed again from the beginning.
+ * ``parse_json`` does this, falling back to the one pass parser.
+ */
+DYND_API bool parse_indexed_json(nd::array &out, const char *json_begin, const char *json_end,
+                                 const eval::eval_context *ectx);
+
 /**
  * Parses the input json as the requested type. The input can be a string or a
  * bytes array. If the input is bytes, the parser assumes it is UTF-8 data.
@@ -94,6 +107,41 @@ inline void parse_json(nd::array &out, const char *json, const eval::eval_contex
   return parse_json(out, json, json + strlen(json), ectx);
 }
 
+/**
+ * Reads newline-delimited JSON, one record of type ``record_tp`` per line,
+ * into an array of type ``var * record_tp`` that grows as records are read.
+ * The input is read in chunks of ``chunk_size`` bytes, and lines that only
+ * hold whitespace are skipped. Errors report the line of the input that
+ * they occurred on.
+ */
+DYND_API nd::array parse_json_lines(const ndt::type &record_tp, std::istream &in,
+                                    const eval::eval_context *ectx = &eval::default_eval_context,
+                                    size_t chunk_size = 1 << 20);
+
+/**
+ * Same as the version given a stream, but reads from a file descriptor, which
+ * is not closed.
+ */
+DYND_API nd::array parse_json_lines(const ndt::type &record_tp, int fd,
+                                    const eval::eval_context *ectx = &eval::default_eval_context,
+                                    size_t chunk_size = 1 << 20);
+
+/**
+ * Reads newline-delimited JSON like the version above, but hands the records
+ * to ``callback`` in batches of type ``N * record_tp``, where N is at most
+ * ``batch_size``. Every batch is a new array, so memory stays proportional
+ * to the batch and the chunk size unless the callback keeps the batches.
+ */
+DYND_API void parse_json_lines(const ndt::type &record_tp, std::istream &in, size_t batch_size,
+                               const std::function<void(const nd::array &)> &callback,
+                               const eval::eval_context *ectx = &eval::default_eval_context,
+                               size_t chunk_size = 1 << 20);
+
+DYND_API void parse_json_lines(const ndt::type &record_tp, int fd, size_t batch_size,
+                               const std::function<void(const nd::array &)> &callback,
+                               const eval::eval_context *ectx = &eval::default_eval_context,
+                               size_t chunk_size = 1 << 20);
+
 /** Interface to the JSON parser for an input of two string literals */
 template <int M, int N>
 inline nd::array parse_json(const char (&dt)[M], const char (&json)[N],
@@ -7,6 +7,7 @@
 
 #include <dynd/kernels/apply.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/simd.hpp>
 
 namespace dynd {
 namespace nd {
@@ -28,11 +29,40 @@ namespace nd {
         typedef apply_args<type_sequence<A...>, std::index_sequence<I...>> args_type;
         typedef apply_kwds<type_sequence<K...>, std::index_sequence<J...>> kwds_type;
 
+        typedef base_strided_kernel<apply_function_kernel, sizeof...(A)> base_type;
+
+        // Unary and binary functions of arithmetic types, like the arithmetic
+        // operators, get a SIMD loop for contiguous data
+        static constexpr bool contiguous_loop_enabled = (sizeof...(A) == 1 || sizeof...(A) == 2) && sizeof...(K) == 0 &&
+                                                        dynd::nd::detail::are_simd_types<R, A...>::value;
+
+        struct function_type {
+          static DYND_SIMD_INLINE R f(A... a) { return func(a...); }
+        };
+
         apply_function_kernel(args_type args, kwds_type kwds) : args_type(args), kwds_type(kwds) {}
 
         void single(char *dst, char *const *DYND_IGNORE_UNUSED(src)) {
           *reinterpret_cast<R *>(dst) = func(apply_arg<A, I>::assign(src[I])..., apply_kwd<K, J>::get()...);
         }
+
+        void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+          strided(dst, dst_stride, src, src_stride, count, std::integral_constant<bool, contiguous_loop_enabled>());
+        }
+
+      private:
+        void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count,
+                     std::true_type) {
+          if (!dynd::nd::detail::try_contiguous_loop<function_type, R, A...>(dst, dst_stride, src, src_stride, count,
+                                                                             std::index_sequence<I...>())) {
+            base_type::strided(dst, dst_stride, src, src_stride, count);
+          }
+        }
+
+        void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count,
+                     std::false_type) {
+          base_type::strided(dst, dst_stride, src, src_stride, count);
+        }
       };
 
       template <typename func_type, func_type func, typename... A, size_t... I, typename... K, size_t... J>
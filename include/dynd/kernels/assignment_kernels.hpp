@@ -1009,11 +1009,13 @@ namespace nd {
       intptr_t m_src_element_size;
       next_unicode_codepoint_t m_next_fn;
       append_unicode_codepoint_t m_append_fn;
+      transcode_ascii_t m_ascii_fn;
 
       assignment_kernel(string_encoding_t dst_encoding, string_encoding_t src_encoding, intptr_t src_element_size,
                         next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn)
           : m_dst_encoding(dst_encoding), m_src_encoding(src_encoding), m_src_element_size(src_element_size),
-            m_next_fn(next_fn), m_append_fn(append_fn) {}
+            m_next_fn(next_fn), m_append_fn(append_fn),
+            m_ascii_fn(get_transcode_ascii_function(dst_encoding, src_encoding)) {}
 
       void single(char *dst, char *const *src) {
         dynd::string *dst_d = reinterpret_cast<dynd::string *>(dst);
@@ -1032,24 +1034,34 @@ namespace nd {
         char *dst_end = dst_d->end();
 
         dst_current = dst_begin;
+        // Runs of ASCII are converted in bulk, which is only tried again after
+        // an ASCII code point so that text that is mostly not ASCII does not
+        // pay for it on every character
+        bool ascii = true;
         while (src_begin < src_end) {
+          if (ascii) {
+            m_ascii_fn(src_begin, src_end, dst_current, dst_end);
+            if (src_begin == src_end) {
+              break;
+            }
+          }
+
+          // Increase the allocated memory as necessary, and append the codepoint
+          if (dst_end - dst_current < 8) {
+            char *dst_begin_saved = dst_begin;
+            dst_d->resize(2 * (dst_end - dst_begin));
+            dst_begin = dst_d->begin();
+            dst_end = dst_d->end();
+            dst_current = dst_begin + (dst_current - dst_begin_saved);
+          }
+
           cp = next_fn(src_begin, src_end);
-          // Append the codepoint, or increase the allocated memory as necessary
           if (cp != 0) {
-            if (dst_end - dst_current >= 8) {
-              append_fn(cp, dst_current, dst_end);
-            } else {
-              char *dst_begin_saved = dst_begin;
-              dst_d->resize(2 * (dst_end - dst_begin));
-              dst_begin = dst_d->begin();
-              dst_end = dst_d->end();
-              dst_current = dst_begin + (dst_current - dst_begin_saved);
-
-              append_fn(cp, dst_current, dst_end);
-            }
+            append_fn(cp, dst_current, dst_end);
           } else {
             break;
           }
+          ascii = cp < 0x80;
         }
 
         // Shrink-wrap the memory to just fit the string
@@ -1297,13 +1309,14 @@ namespace nd {
         : base_strided_kernel<assignment_kernel<ndt::fixed_string_type, ndt::fixed_string_type, ErrorMode>, 1> {
       next_unicode_codepoint_t m_next_fn;
       append_unicode_codepoint_t m_append_fn;
+      transcode_ascii_t m_ascii_fn;
       intptr_t m_dst_data_size, m_src_data_size;
       bool m_overflow_check;
 
-      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn, intptr_t dst_data_size,
-                        intptr_t src_data_size, bool overflow_check)
-          : m_next_fn(next_fn), m_append_fn(append_fn), m_dst_data_size(dst_data_size), m_src_data_size(src_data_size),
-            m_overflow_check(overflow_check) {}
+      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn,
+                        transcode_ascii_t ascii_fn, intptr_t dst_data_size, intptr_t src_data_size, bool overflow_check)
+          : m_next_fn(next_fn), m_append_fn(append_fn), m_ascii_fn(ascii_fn), m_dst_data_size(dst_data_size),
+            m_src_data_size(src_data_size), m_overflow_check(overflow_check) {}
 
       void single(char *dst, char *const *src) {
         char *dst_end = dst + m_dst_data_size;
@@ -1312,9 +1325,19 @@ namespace nd {
         append_unicode_codepoint_t append_fn = m_append_fn;
         uint32_t cp = 0;
 
-        char *src_copy = src[0];
+        const char *src_copy = src[0];
+        // Runs of ASCII are converted in bulk, tried again after each ASCII
+        // code point
+        bool ascii = true;
         while (src_copy < src_end && dst < dst_end) {
-          cp = next_fn(const_cast<const char *&>(src_copy), src_end);
+          if (ascii) {
+            m_ascii_fn(src_copy, src_end, dst, dst_end);
+            if (src_copy == src_end || dst == dst_end) {
+              break;
+            }
+          }
+
+          cp = next_fn(src_copy, src_end);
           // The fixed_string type uses null-terminated strings
           if (cp == 0) {
             // Null-terminate the destination string, and we're done
@@ -1323,6 +1346,7 @@ namespace nd {
           } else {
             append_fn(cp, dst, dst_end);
           }
+          ascii = cp < 0x80;
         }
         if (src_copy < src_end) {
           if (m_overflow_check) {
@@ -1359,12 +1383,13 @@ namespace nd {
         : base_strided_kernel<assignment_kernel<ndt::fixed_string_type, string, ErrorMode>, 1> {
       next_unicode_codepoint_t m_next_fn;
       append_unicode_codepoint_t m_append_fn;
+      transcode_ascii_t m_ascii_fn;
       intptr_t m_dst_data_size;
       bool m_overflow_check;
 
-      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn, intptr_t dst_data_size,
-                        bool overflow_check)
-          : m_next_fn(next_fn), m_append_fn(append_fn), m_dst_data_size(dst_data_size),
+      assignment_kernel(next_unicode_codepoint_t next_fn, append_unicode_codepoint_t append_fn,
+                        transcode_ascii_t ascii_fn, intptr_t dst_data_size, bool overflow_check)
+          : m_next_fn(next_fn), m_append_fn(append_fn), m_ascii_fn(ascii_fn), m_dst_data_size(dst_data_size),
             m_overflow_check(overflow_check) {}
 
       void single(char *dst, char *const *src) {
@@ -1376,9 +1401,20 @@ namespace nd {
         append_unicode_codepoint_t append_fn = m_append_fn;
         uint32_t cp;
 
+        // Runs of ASCII are converted in bulk, tried again after each ASCII
+        // code point
+        bool ascii = true;
         while (src_begin < src_end && dst < dst_end) {
+          if (ascii) {
+            m_ascii_fn(src_begin, src_end, dst, dst_end);
+            if (src_begin == src_end || dst == dst_end) {
+              break;
+            }
+          }
+
           cp = next_fn(src_begin, src_end);
           append_fn(cp, dst, dst_end);
+          ascii = cp < 0x80;
         }
         if (src_begin < src_end) {
           if (m_overflow_check) {
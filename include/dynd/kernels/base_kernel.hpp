@@ -9,6 +9,7 @@
 
 #include <dynd/array.hpp>
 #include <dynd/kernels/kernel_prefix.hpp>
+#include <dynd/kernels/kernel_profiler.hpp>
 
 namespace dynd {
 namespace nd {
@@ -70,10 +71,10 @@ namespace nd {
       self->destructor = SelfType::destruct;
       switch (kernreq) {
       case kernel_request_call:
-        self->function = reinterpret_cast<void *>(SelfType::call_wrapper);
+        self->function = profiled_call_function<SelfType, array, const array, SelfType::call_wrapper>();
         break;
       case kernel_request_single:
-        self->function = reinterpret_cast<void *>(SelfType::single_wrapper);
+        self->function = profiled_single_function<SelfType, SelfType::single_wrapper>();
         break;
       default:
         DYND_HOST_THROW(std::invalid_argument,
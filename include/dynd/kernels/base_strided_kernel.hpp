@@ -27,13 +27,13 @@ namespace nd {
       self->destructor = SelfType::destruct;
       switch (kernreq) {
       case kernel_request_call:
-        self->function = reinterpret_cast<void *>(SelfType::call_wrapper);
+        self->function = profiled_call_function<SelfType, array, const array, SelfType::call_wrapper>();
         break;
       case kernel_request_single:
-        self->function = reinterpret_cast<void *>(SelfType::single_wrapper);
+        self->function = profiled_single_function<SelfType, SelfType::single_wrapper>();
         break;
       case kernel_request_strided:
-        self->function = reinterpret_cast<void *>(SelfType::strided_wrapper);
+        self->function = profiled_strided_function<SelfType, SelfType::strided_wrapper>();
         break;
       default:
         DYND_HOST_THROW(std::invalid_argument,
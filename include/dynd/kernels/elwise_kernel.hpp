@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+
 #include <dynd/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/parallel.hpp>
 
 namespace dynd {
 namespace nd {
@@ -77,6 +81,99 @@ namespace nd {
       }
     };
 
+    /**
+     * Expr kernel for the outermost strided dimension of an elementwise
+     * operation, which splits the dimension over threads with
+     * ``parallel_for``. Every worker runs its own instance of the child kernel,
+     * so child kernels with per-call state are never shared between threads.
+     */
+    template <size_t N>
+    struct parallel_elwise_kernel : base_strided_kernel<parallel_elwise_kernel<N>, N> {
+      intptr_t m_size;
+      intptr_t m_dst_stride;
+      std::array<intptr_t, N> m_src_stride;
+      size_t m_nthreads;
+      size_t m_grain_size;
+      std::vector<intptr_t> m_child_offset;
+
+      parallel_elwise_kernel(intptr_t size, intptr_t dst_stride, const intptr_t *src_stride, size_t nthreads,
+                             size_t grain_size)
+          : m_size(size), m_dst_stride(dst_stride), m_nthreads(nthreads), m_grain_size(grain_size) {
+        for (size_t i = 0; i < N; ++i) {
+          m_src_stride[i] = src_stride[i];
+        }
+      }
+
+      ~parallel_elwise_kernel() {
+        for (intptr_t offset : m_child_offset) {
+          this->get_child(offset)->destroy();
+        }
+      }
+
+      void single(char *dst, char *const *src) {
+        parallel_for(m_size, m_grain_size, m_nthreads, [&](size_t begin, size_t end, size_t worker) {
+          kernel_prefix *child = this->get_child(m_child_offset[worker]);
+
+          std::array<char *, N> child_src;
+          for (size_t i = 0; i < N; ++i) {
+            child_src[i] = src[i] + begin * m_src_stride[i];
+          }
+
+          child->strided(dst + begin * m_dst_stride, m_dst_stride, child_src.data(), m_src_stride.data(), end - begin);
+        });
+      }
+    };
+
+    /**
+     * Expr kernel for the two innermost strided dimensions of an elementwise
+     * operation whose operands disagree on which of them has the smaller
+     * stride, as when copying between C and Fortran order. The dimensions are
+     * walked in square tiles, so the operands that step through memory along
+     * the outer dimension reuse the cache lines and pages of a tile instead of
+     * touching a new one for every element.
+     */
+    template <size_t N>
+    struct tiled_elwise_kernel : base_strided_kernel<tiled_elwise_kernel<N>, N> {
+      static const intptr_t tile_size = 32;
+
+      intptr_t m_outer_size, m_inner_size;
+      intptr_t m_dst_outer_stride, m_dst_inner_stride;
+      std::array<intptr_t, N> m_src_outer_stride, m_src_inner_stride;
+
+      tiled_elwise_kernel(intptr_t outer_size, intptr_t inner_size, intptr_t dst_outer_stride,
+                          intptr_t dst_inner_stride, const intptr_t *src_outer_stride,
+                          const intptr_t *src_inner_stride)
+          : m_outer_size(outer_size), m_inner_size(inner_size), m_dst_outer_stride(dst_outer_stride),
+            m_dst_inner_stride(dst_inner_stride) {
+        for (size_t i = 0; i < N; ++i) {
+          m_src_outer_stride[i] = src_outer_stride[i];
+          m_src_inner_stride[i] = src_inner_stride[i];
+        }
+      }
+
+      ~tiled_elwise_kernel() { this->get_child()->destroy(); }
+
+      void single(char *dst, char *const *src) {
+        kernel_prefix *child = this->get_child();
+        kernel_strided_t opchild = child->get_function<kernel_strided_t>();
+
+        std::array<char *, N> child_src;
+        for (intptr_t outer_begin = 0; outer_begin < m_outer_size; outer_begin += tile_size) {
+          intptr_t outer_end = std::min(outer_begin + tile_size, m_outer_size);
+          for (intptr_t inner_begin = 0; inner_begin < m_inner_size; inner_begin += tile_size) {
+            intptr_t inner_size = std::min(tile_size, m_inner_size - inner_begin);
+            for (intptr_t j = outer_begin; j < outer_end; ++j) {
+              for (size_t i = 0; i < N; ++i) {
+                child_src[i] = src[i] + j * m_src_outer_stride[i] + inner_begin * m_src_inner_stride[i];
+              }
+              opchild(child, dst + j * m_dst_outer_stride + inner_begin * m_dst_inner_stride, m_dst_inner_stride,
+                      child_src.data(), m_src_inner_stride.data(), inner_size);
+            }
+          }
+        }
+      }
+    };
+
     /**
      * Generic expr kernel + destructor for a strided/var dimensions with
      * a fixed number of src operands, outputing to a strided dimension.
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A kernel for a chain of elementwise kernels that is evaluated in one
+     * strided pass, a block of DYND_BUFFER_CHUNK_SIZE elements at a time.
+     *
+     * The values that a step reads are identified by slots, where slots
+     * [0, nsrc) are the arguments of the kernel and slot nsrc + i is the result
+     * of step i. The results of all steps but the last live in scratch buffers
+     * that are reused from block to block, and the last step writes to "dst".
+     */
+    // All methods are inlined, so this does not need to be declared DYND_API.
+    struct fused_kernel : base_strided_kernel<fused_kernel> {
+      // The most arguments that the lifted kernel supports
+      static const size_t max_nsrc = 7;
+
+      size_t m_nsrc;
+      std::vector<intptr_t> m_arg_slot;
+      std::vector<size_t> m_arg_begin;
+      std::vector<intptr_t> m_buffer_offset;
+      std::vector<intptr_t> m_buffer_stride;
+      std::vector<intptr_t> m_child_offset;
+      std::vector<uint64_t> m_buffer;
+      // Scratch space for the arguments of the steps, so that evaluating a
+      // block does not allocate
+      std::vector<char *> m_child_src;
+      std::vector<intptr_t> m_child_src_stride;
+      // The strides of a single element, which are all zero
+      intptr_t m_single_src_stride[max_nsrc];
+
+      fused_kernel(size_t nsrc, const std::vector<intptr_t> &arg_slot, const std::vector<size_t> &arg_begin,
+                   const std::vector<intptr_t> &buffer_size)
+          : m_nsrc(nsrc), m_arg_slot(arg_slot), m_arg_begin(arg_begin), m_child_src(arg_slot.size()),
+            m_child_src_stride(arg_slot.size()), m_single_src_stride() {
+        intptr_t offset = 0;
+        for (intptr_t size : buffer_size) {
+          m_buffer_offset.push_back(offset);
+          m_buffer_stride.push_back(aligned_size(size));
+          offset += aligned_size(size) * DYND_BUFFER_CHUNK_SIZE;
+        }
+        m_buffer.resize(offset / sizeof(uint64_t));
+      }
+
+      ~fused_kernel() {
+        for (intptr_t offset : m_child_offset) {
+          get_child(offset)->destroy();
+        }
+      }
+
+      void call(array *dst, const array *src) {
+        char *src_data[max_nsrc];
+        for (size_t i = 0; i < m_nsrc; ++i) {
+          src_data[i] = const_cast<char *>(src[i].cdata());
+        }
+
+        single(const_cast<char *>(dst->cdata()), src_data);
+      }
+
+      void single(char *dst, char *const *src) { strided(dst, 0, src, m_single_src_stride, 1); }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        size_t nsteps = m_child_offset.size();
+        char *buffer = reinterpret_cast<char *>(m_buffer.data());
+
+        for (size_t offset = 0; offset < count; offset += DYND_BUFFER_CHUNK_SIZE) {
+          size_t chunk_size = std::min(count - offset, static_cast<size_t>(DYND_BUFFER_CHUNK_SIZE));
+
+          for (size_t i = 0; i < nsteps; ++i) {
+            for (size_t j = m_arg_begin[i]; j < m_arg_begin[i + 1]; ++j) {
+              size_t slot = static_cast<size_t>(m_arg_slot[j]);
+              if (slot < m_nsrc) {
+                m_child_src[j] = src[slot] + offset * src_stride[slot];
+                m_child_src_stride[j] = src_stride[slot];
+              } else {
+                m_child_src[j] = buffer + m_buffer_offset[slot - m_nsrc];
+                m_child_src_stride[j] = m_buffer_stride[slot - m_nsrc];
+              }
+            }
+
+            kernel_prefix *child = get_child(m_child_offset[i]);
+            if (i + 1 < nsteps) {
+              child->strided(buffer + m_buffer_offset[i], m_buffer_stride[i], m_child_src.data() + m_arg_begin[i],
+                             m_child_src_stride.data() + m_arg_begin[i], chunk_size);
+            } else {
+              child->strided(dst + offset * dst_stride, dst_stride, m_child_src.data() + m_arg_begin[i],
+                             m_child_src_stride.data() + m_arg_begin[i], chunk_size);
+            }
+          }
+        }
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
@@ -43,6 +43,14 @@ namespace nd {
 
     void pass() { m_call = reinterpret_cast<call_node *>(reinterpret_cast<char *>(m_call) + m_call->data_size); }
 
+    /**
+     * Returns the call node that the next instantiation starts from. Passing
+     * it back to ``rewind`` later instantiates the same child kernel again.
+     */
+    call_node *get_call() const { return m_call; }
+
+    void rewind(call_node *call) { m_call = call; }
+
     void operator()(kernel_request_t kr, char *data, const char *res_metadata, size_t narg,
                     const char *const *arg_metadata) {
       m_call->instantiate(m_call, this, kr, data, res_metadata, narg, arg_metadata);
@@ -0,0 +1,187 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <dynd/kernels/kernel_prefix.hpp>
+
+namespace dynd {
+
+/**
+ * Returns true if kernels are being instrumented as they are built.
+ */
+DYND_API bool kernel_profiling_enabled();
+
+/**
+ * Turns kernel profiling on or off. While it is on, every kernel that is
+ * built has its function pointer wrapped with one that counts its calls and
+ * elements and times them. Kernels that were built while it was off are not
+ * affected, and kernels that were built while it was on keep recording after
+ * it is turned off.
+ */
+DYND_API void set_kernel_profiling(bool enabled);
+
+namespace nd {
+
+  /**
+   * The statistics of one kernel type, either at a single position in the
+   * tree of kernels that called each other, or summed over all of them.
+   */
+  struct kernel_profile_entry {
+    std::string name;
+    /** The number of times the kernel function was called */
+    uint64_t calls;
+    /** The number of elements processed, one per single call and count per strided call */
+    uint64_t elements;
+    /** The time spent inside the kernel function, including its children */
+    uint64_t nanoseconds;
+    /** The kernels that were called from inside this one */
+    std::vector<kernel_profile_entry> children;
+
+    kernel_profile_entry(const std::string &name = std::string()) : name(name), calls(0), elements(0), nanoseconds(0) {}
+
+    /**
+     * The time spent inside the kernel function, excluding its children.
+     */
+    uint64_t self_nanoseconds() const {
+      uint64_t res = nanoseconds;
+      for (const kernel_profile_entry &child : children) {
+        res -= std::min(res, child.nanoseconds);
+      }
+
+      return res;
+    }
+  };
+
+  /**
+   * Returns the recorded statistics as a tree that mirrors how the kernels
+   * called each other, below an unnamed root entry whose children are the
+   * outermost kernels of each call. Children are ordered by decreasing time.
+   */
+  DYND_API kernel_profile_entry get_kernel_profile();
+
+  /**
+   * Returns the recorded statistics summed per kernel type. Here the time
+   * excludes children, and the entries are ordered by decreasing time.
+   */
+  DYND_API std::vector<kernel_profile_entry> get_kernel_profile_by_type();
+
+  /**
+   * Zeroes all the recorded statistics.
+   */
+  DYND_API void reset_kernel_profile();
+
+  /**
+   * Prints the tree returned by ``get_kernel_profile``, one indented line
+   * per kernel.
+   */
+  DYND_API void print_kernel_profile(std::ostream &o);
+
+  namespace detail {
+
+    /**
+     * A node of the tree of recorded kernel calls. Nodes are never freed, so
+     * that a running kernel can keep recording into them while the profile is
+     * read or reset on another thread.
+     */
+    struct kernel_profile_node {
+      const std::type_info *type;
+      std::atomic<uint64_t> calls;
+      std::atomic<uint64_t> elements;
+      std::atomic<uint64_t> nanoseconds;
+      std::atomic<kernel_profile_node *> first_child;
+      kernel_profile_node *next_sibling;
+
+      kernel_profile_node(const std::type_info *type)
+          : type(type), calls(0), elements(0), nanoseconds(0), first_child(nullptr), next_sibling(nullptr) {}
+    };
+
+    /**
+     * Makes the node for ``type`` below the current node of the calling
+     * thread its current node, and returns it together with the previous one.
+     */
+    DYND_API kernel_profile_node *enter_kernel_profile(const std::type_info &type, kernel_profile_node *&parent);
+
+    /**
+     * Restores ``parent`` as the current node of the calling thread.
+     */
+    DYND_API void exit_kernel_profile(kernel_profile_node *parent);
+
+    class kernel_profile_scope {
+      kernel_profile_node *m_parent;
+      kernel_profile_node *m_node;
+      uint64_t m_elements;
+      std::chrono::steady_clock::time_point m_start;
+
+    public:
+      kernel_profile_scope(const std::type_info &type, uint64_t elements)
+          : m_parent(nullptr), m_node(enter_kernel_profile(type, m_parent)), m_elements(elements),
+            m_start(std::chrono::steady_clock::now()) {}
+
+      ~kernel_profile_scope() {
+        uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                                m_start).count();
+        m_node->calls.fetch_add(1, std::memory_order_relaxed);
+        m_node->elements.fetch_add(m_elements, std::memory_order_relaxed);
+        m_node->nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        exit_kernel_profile(m_parent);
+      }
+    };
+
+    template <typename SelfType, typename DstType, typename SrcType, void (*Func)(kernel_prefix *, DstType *, SrcType *)>
+    void profiled_call(kernel_prefix *self, DstType *dst, SrcType *src) {
+      kernel_profile_scope scope(typeid(SelfType), 1);
+      Func(self, dst, src);
+    }
+
+    template <typename SelfType, kernel_single_t Func>
+    void profiled_single(kernel_prefix *self, char *dst, char *const *src) {
+      kernel_profile_scope scope(typeid(SelfType), 1);
+      Func(self, dst, src);
+    }
+
+    template <typename SelfType, kernel_strided_t Func>
+    void profiled_strided(kernel_prefix *self, char *dst, intptr_t dst_stride, char *const *src,
+                          const intptr_t *src_stride, size_t count) {
+      kernel_profile_scope scope(typeid(SelfType), count);
+      Func(self, dst, dst_stride, src, src_stride, count);
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Returns the function pointer that a kernel of type ``SelfType`` should
+   * use for ``Func``, which is ``Func`` wrapped for profiling if that is
+   * enabled, and ``Func`` itself otherwise.
+   */
+  template <typename SelfType, typename DstType, typename SrcType, void (*Func)(kernel_prefix *, DstType *, SrcType *)>
+  void *profiled_call_function() {
+    return kernel_profiling_enabled()
+               ? reinterpret_cast<void *>(&detail::profiled_call<SelfType, DstType, SrcType, Func>)
+               : reinterpret_cast<void *>(Func);
+  }
+
+  template <typename SelfType, kernel_single_t Func>
+  void *profiled_single_function() {
+    return kernel_profiling_enabled() ? reinterpret_cast<void *>(&detail::profiled_single<SelfType, Func>)
+                                      : reinterpret_cast<void *>(Func);
+  }
+
+  template <typename SelfType, kernel_strided_t Func>
+  void *profiled_strided_function() {
+    return kernel_profiling_enabled() ? reinterpret_cast<void *>(&detail::profiled_strided<SelfType, Func>)
+                                      : reinterpret_cast<void *>(Func);
+  }
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/simd.hpp>
 
 namespace dynd {
 namespace nd {
@@ -25,6 +26,14 @@ namespace nd {
     void single(char *dst, char *const *src) {
       *reinterpret_cast<bool1 *>(dst) = *reinterpret_cast<Arg0Type *>(src[0]) <= *reinterpret_cast<Arg0Type *>(src[1]);
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      typedef base_strided_kernel<less_equal_kernel<Arg0Type, Arg0Type>, 2> base_type;
+      if (!detail::try_contiguous_comparison<detail::simd_less_equal, Arg0Type>(dst, dst_stride, src, src_stride,
+                                                                                count)) {
+        base_type::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
   };
 
 } // namespace dynd::nd
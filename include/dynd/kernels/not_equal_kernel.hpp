@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/types/callable_type.hpp>
 
 namespace dynd {
@@ -27,6 +28,14 @@ namespace nd {
       *reinterpret_cast<bool1 *>(res) =
           *reinterpret_cast<Arg0Type *>(args[0]) != *reinterpret_cast<Arg0Type *>(args[1]);
     }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+      typedef base_strided_kernel<not_equal_kernel<Arg0Type, Arg0Type>, 2> base_type;
+      if (!detail::try_contiguous_comparison<detail::simd_not_equal, Arg0Type>(dst, dst_stride, src, src_stride,
+                                                                               count)) {
+        base_type::strided(dst, dst_stride, src, src_stride, count);
+      }
+    }
   };
 
   template <>
@@ -11,6 +11,7 @@
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/constant_kernel.hpp>
 #include <dynd/kernels/reduction_kernel_prefix.hpp>
+#include <dynd/parallel.hpp>
 
 namespace dynd {
 namespace nd {
@@ -52,13 +53,13 @@ namespace nd {
         // Get the function pointer for the first_call
         switch (kernreq) {
         case kernel_request_call:
-          self->set_first_call_function(SelfType::call_wrapper);
+          self->function = profiled_call_function<SelfType, array, array, SelfType::call_wrapper>();
           break;
         case kernel_request_single:
-          self->set_first_call_function(SelfType::single_first_wrapper);
+          self->function = profiled_single_function<SelfType, SelfType::single_first_wrapper>();
           break;
         case kernel_request_strided:
-          self->set_first_call_function(SelfType::strided_first_wrapper);
+          self->function = profiled_strided_function<SelfType, SelfType::strided_first_wrapper>();
           break;
         default:
           std::stringstream ss;
@@ -66,7 +67,8 @@ namespace nd {
           throw std::runtime_error(ss.str());
         }
         // The function pointer for followup accumulation calls
-        self->set_followup_call_function(SelfType::strided_followup_wrapper);
+        self->set_followup_call_function(reinterpret_cast<kernel_strided_t>(
+            profiled_strided_function<SelfType, SelfType::strided_followup_wrapper>()));
       }
 
       static void destruct(kernel_prefix *self) { reinterpret_cast<SelfType *>(self)->~SelfType(); }
@@ -319,6 +321,128 @@ namespace nd {
       }
     };
 
+    /**
+     * STRIDED INNER REDUCTION DIMENSION, IN PARALLEL
+     * This ckernel handles the same case as the one above for a unary
+     * reduction whose accumulator has the type of its argument, and
+     * splits the dimension into chunks that are reduced on separate threads.
+     *
+     * Every chunk is reduced into a partial result that starts out as a
+     * copy of its first element, so the identity is only applied once to
+     * "dst". The partial results are then combined pairwise in chunk order,
+     * which requires associativity but not commutativity, and makes the
+     * result independent of how the chunks were scheduled.
+     *
+     * Requirements:
+     *  - The child destination initialization kernel must be *single*.
+     *  - The child reduction kernels, one per worker, must be *strided*.
+     *
+     */
+    struct parallel_reduction_kernel : base_reduction_kernel<parallel_reduction_kernel, 1> {
+      intptr_t m_size;
+      intptr_t m_src_stride;
+      size_t m_data_size;
+      size_t m_chunk_size;
+      size_t m_nchunks;
+      size_t m_nthreads;
+      size_t m_init_offset;
+      std::vector<intptr_t> m_child_offset;
+      std::vector<uint64_t> m_partials;
+
+      parallel_reduction_kernel(intptr_t size, intptr_t src_stride, size_t data_size, size_t nthreads,
+                                size_t grain_size)
+          : m_size(size), m_src_stride(src_stride), m_data_size(data_size), m_init_offset(0) {
+        // Aim for a few chunks per thread so that uneven chunks balance out
+        size_t count = static_cast<size_t>(size);
+        m_chunk_size =
+            std::max(std::max(grain_size, static_cast<size_t>(1)), (count + 4 * nthreads - 1) / (4 * nthreads));
+        m_nchunks = (count + m_chunk_size - 1) / m_chunk_size;
+        m_nthreads = std::min(nthreads, m_nchunks);
+        m_partials.resize(m_nchunks * (aligned_size(data_size) / sizeof(uint64_t)));
+      }
+
+      ~parallel_reduction_kernel() {
+        for (intptr_t offset : m_child_offset) {
+          this->get_child(offset)->destroy();
+        }
+        if (m_init_offset != 0) {
+          this->get_child(m_init_offset)->destroy();
+        }
+      }
+
+      char *get_partial(size_t i) {
+        return reinterpret_cast<char *>(m_partials.data()) + i * aligned_size(m_data_size);
+      }
+
+      /**
+       * Reduces ``src`` into the partial results of the chunks, and returns
+       * their combination.
+       */
+      char *reduce(char *src) {
+        parallel_for(m_nchunks, 1, m_nthreads, [&](size_t begin, size_t end, size_t worker) {
+          kernel_prefix *child = this->get_child(m_child_offset[worker]);
+          for (size_t i = begin; i < end; ++i) {
+            size_t chunk_begin = i * m_chunk_size;
+            size_t chunk_size = std::min(m_chunk_size, static_cast<size_t>(m_size) - chunk_begin);
+
+            char *partial = get_partial(i);
+            char *child_src = src + chunk_begin * m_src_stride;
+            memcpy(partial, child_src, m_data_size);
+            child_src += m_src_stride;
+            child->strided(partial, 0, &child_src, &m_src_stride, chunk_size - 1);
+          }
+        });
+
+        for (size_t step = 1; step < m_nchunks; step *= 2) {
+          for (size_t i = 0; i + step < m_nchunks; i += 2 * step) {
+            combine(get_partial(i), get_partial(i + step));
+          }
+        }
+
+        return get_partial(0);
+      }
+
+      /**
+       * Accumulates ``src`` into ``dst`` with the child of the first worker,
+       * which is a strided kernel.
+       */
+      void combine(char *dst, char *src) {
+        const intptr_t src_stride = 0;
+        this->get_child(m_child_offset[0])->strided(dst, 0, &src, &src_stride, 1);
+      }
+
+      void single_first(char *dst, char *const *src) {
+        this->get_child(m_init_offset)->single(dst, src);
+
+        combine(dst, reduce(src[0]));
+      }
+
+      void strided_first(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) {
+        char *src0 = src[0];
+        for (size_t i = 0; i != count; ++i) {
+          if (i == 0 || dst_stride != 0) {
+            single_first(dst, &src0);
+          } else {
+            strided_followup(dst, 0, &src0, src_stride, 1);
+          }
+
+          dst += dst_stride;
+          src0 += src_stride[0];
+        }
+      }
+
+      void strided_followup(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                            size_t count) {
+        char *src0 = src[0];
+        for (size_t i = 0; i != count; ++i) {
+          combine(dst, reduce(src0));
+
+          dst += dst_stride;
+          src0 += src_stride[0];
+        }
+      }
+    };
+
     template <size_t NArg>
     struct reduction_kernel<ndt::var_dim_type, false, true, NArg>
         : base_reduction_kernel<reduction_kernel<ndt::var_dim_type, false, true, NArg>, NArg> {
@@ -0,0 +1,261 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/kernels/sort_kernel.hpp>
+#include <dynd/parallel.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * Finds the insertion index of every needle in a sorted haystack through a
+   * ``less`` child kernel, with one comparison per probe. With ``right`` set,
+   * the index is after any equal values instead of before them.
+   */
+  struct searchsorted_kernel : base_strided_kernel<searchsorted_kernel, 2> {
+    const intptr_t m_src0_size;
+    const intptr_t m_src0_stride;
+    const intptr_t m_src1_size;
+    const intptr_t m_src1_stride;
+    const intptr_t m_dst_stride;
+    const bool m_right;
+
+    searchsorted_kernel(intptr_t src0_size, intptr_t src0_stride, intptr_t src1_size, intptr_t src1_stride,
+                        intptr_t dst_stride, bool right)
+        : m_src0_size(src0_size), m_src0_stride(src0_stride), m_src1_size(src1_size), m_src1_stride(src1_stride),
+          m_dst_stride(dst_stride), m_right(right) {}
+
+    ~searchsorted_kernel() { get_child()->destroy(); }
+
+    void single(char *dst, char *const *src) {
+      kernel_prefix *child = get_child();
+      for (intptr_t i = 0; i < m_src1_size; ++i) {
+        char *needle = src[1] + i * m_src1_stride;
+        intptr_t first = 0, last = m_src0_size;
+        while (first < last) {
+          intptr_t trial = first + (last - first) / 2;
+          char *trial_data = src[0] + trial * m_src0_stride;
+
+          // The child is ``less(arr[trial], value)`` on the left side and
+          // ``less(value, arr[trial])`` on the right side
+          char *child_src[2] = {trial_data, needle};
+          if (m_right) {
+            std::swap(child_src[0], child_src[1]);
+          }
+          bool1 child_dst;
+          child->single(reinterpret_cast<char *>(&child_dst), child_src);
+          if (static_cast<bool>(child_dst) != m_right) {
+            first = trial + 1;
+          } else {
+            last = trial;
+          }
+        }
+
+        *reinterpret_cast<int64_t *>(dst + i * m_dst_stride) = first;
+      }
+    }
+  };
+
+  namespace detail {
+
+    /**
+     * Whether a haystack value goes before the needle, i.e. whether the
+     * search continues to its right. That is ``value < needle`` on the left
+     * side and ``!(needle < value)`` on the right side, in the order that
+     * ``sort`` uses.
+     */
+    template <typename T, bool Right>
+    struct search_before {
+      bool operator()(T value, T needle) const {
+        return Right ? !sort_less<T>()(needle, value) : sort_less<T>()(value, needle);
+      }
+    };
+
+    /**
+     * A binary search over contiguous data whose loop has no data-dependent
+     * branches, so the compiler turns the probe into a conditional move and
+     * there are no mispredictions. Returns the number of values before the
+     * needle.
+     */
+    template <typename T, bool Right>
+    size_t branchless_search(const T *data, size_t size, T needle) {
+      if (size == 0) {
+        return 0;
+      }
+
+      search_before<T, Right> before;
+      const T *base = data;
+      while (size > 1) {
+        size_t half = size / 2;
+        base = before(base[half], needle) ? base + half : base;
+        size -= half;
+      }
+
+      return (base - data) + before(*base, needle);
+    }
+
+    /**
+     * A sorted array stored in breadth-first order of its implicit binary
+     * search tree, i.e. the children of node ``k`` are ``2k`` and ``2k + 1``
+     * with the root at 1. The first levels of the tree share cache lines, and
+     * the nodes of a level further down can be prefetched a few levels ahead,
+     * so large haystacks that do not fit in cache search much faster than
+     * they do in sorted order.
+     */
+    template <typename T>
+    class eytzinger_layout {
+      std::vector<T> m_nodes;
+      // The index in sorted order of each node
+      std::vector<size_t> m_ranks;
+
+      size_t fill(const T *sorted, size_t i, size_t k) {
+        if (k < m_nodes.size()) {
+          i = fill(sorted, i, 2 * k);
+          m_nodes[k] = sorted[i];
+          m_ranks[k] = i++;
+          i = fill(sorted, i, 2 * k + 1);
+        }
+
+        return i;
+      }
+
+    public:
+      void assign(const T *sorted, size_t size) {
+        m_nodes.resize(size + 1);
+        m_ranks.resize(size + 1);
+        fill(sorted, 0, 1);
+        // The rank of the position after the last value
+        m_ranks[0] = size;
+      }
+
+      template <bool Right>
+      size_t search(T needle) const {
+        const T *nodes = m_nodes.data();
+        size_t size = m_nodes.size() - 1;
+        search_before<T, Right> before;
+
+        size_t k = 1;
+        while (k <= size) {
+#ifdef __GNUC__
+          // The great-great-grandchildren of k are 16 contiguous nodes
+          __builtin_prefetch(nodes + 16 * k);
+#endif
+          k = 2 * k + before(nodes[k], needle);
+        }
+        // Undo the right turns after the last left turn, the node of which is
+        // the first one the needle goes before, or 0 if there is none
+        k >>= count_trailing_ones(k) + 1;
+
+        return m_ranks[k];
+      }
+
+      static int count_trailing_ones(size_t k) {
+#ifdef __GNUC__
+        return ~k == 0 ? static_cast<int>(8 * sizeof(size_t)) : __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+        int res = 0;
+        while (k & 1) {
+          k >>= 1;
+          ++res;
+        }
+        return res;
+#endif
+      }
+    };
+
+    /**
+     * Haystacks from this size on are searched in the Eytzinger layout, if
+     * there are enough needles to pay for building it.
+     */
+    const size_t eytzinger_search_threshold = 1 << 12;
+
+    /**
+     * From this number of needles on, searches may be split over threads.
+     */
+    const size_t parallel_search_threshold = 1 << 14;
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Finds the insertion indices of builtin integers or floats without going
+   * through a comparison kernel. A strided haystack is gathered into a
+   * contiguous buffer first, and large haystacks with many needles are
+   * rearranged into the Eytzinger layout. The needles may be split over
+   * ``nthreads`` threads.
+   */
+  template <typename T>
+  struct typed_searchsorted_kernel : base_strided_kernel<typed_searchsorted_kernel<T>, 2> {
+    const intptr_t m_src0_size;
+    const intptr_t m_src0_stride;
+    const intptr_t m_src1_size;
+    const intptr_t m_src1_stride;
+    const intptr_t m_dst_stride;
+    const bool m_right;
+    const size_t m_nthreads;
+    std::vector<T> m_buffer;
+    detail::eytzinger_layout<T> m_eytzinger;
+
+    typed_searchsorted_kernel(intptr_t src0_size, intptr_t src0_stride, intptr_t src1_size, intptr_t src1_stride,
+                              intptr_t dst_stride, bool right, size_t nthreads)
+        : m_src0_size(src0_size), m_src0_stride(src0_stride), m_src1_size(src1_size), m_src1_stride(src1_stride),
+          m_dst_stride(dst_stride), m_right(right), m_nthreads(nthreads) {}
+
+    template <typename SearchType>
+    void search_needles(char *dst, const char *needles, const SearchType &search) {
+      size_t count = m_src1_size;
+      auto search_range = [&](size_t begin, size_t end, size_t DYND_UNUSED(worker)) {
+        for (size_t i = begin; i < end; ++i) {
+          T needle;
+          memcpy(&needle, needles + i * m_src1_stride, sizeof(T));
+          *reinterpret_cast<int64_t *>(dst + i * m_dst_stride) = search(needle);
+        }
+      };
+
+      if (m_nthreads > 1 && count >= detail::parallel_search_threshold && !in_parallel_region()) {
+        parallel_for(count, detail::parallel_search_threshold / 4, m_nthreads, search_range);
+      } else {
+        search_range(0, count, 0);
+      }
+    }
+
+    template <bool Right>
+    void search_all(char *dst, const char *needles, const T *haystack) {
+      size_t size = m_src0_size;
+      if (size >= detail::eytzinger_search_threshold && static_cast<size_t>(m_src1_size) >= size / 8) {
+        m_eytzinger.assign(haystack, size);
+        search_needles(dst, needles, [this](T needle) { return m_eytzinger.template search<Right>(needle); });
+      } else {
+        search_needles(dst, needles, [haystack, size](T needle) {
+          return detail::branchless_search<T, Right>(haystack, size, needle);
+        });
+      }
+    }
+
+    void single(char *dst, char *const *src) {
+      const T *haystack = reinterpret_cast<const T *>(src[0]);
+      if (m_src0_stride != static_cast<intptr_t>(sizeof(T))) {
+        m_buffer.resize(m_src0_size);
+        for (intptr_t i = 0; i < m_src0_size; ++i) {
+          memcpy(&m_buffer[i], src[0] + i * m_src0_stride, sizeof(T));
+        }
+        haystack = m_buffer.data();
+      }
+
+      if (m_right) {
+        search_all<true>(dst, src[1], haystack);
+      } else {
+        search_all<false>(dst, src[1], haystack);
+      }
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
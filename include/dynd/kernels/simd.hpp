@@ -0,0 +1,182 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <dynd/config.hpp>
+
+// On x86 with GCC or Clang, the contiguous loops below are compiled once per
+// instruction set with function target attributes, and the widest one the CPU
+// supports is picked at runtime. Elsewhere a single baseline loop is used.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DYND_SIMD_DISPATCH
+#define DYND_SIMD_TARGET(ISA) __attribute__((target(ISA)))
+#define DYND_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define DYND_SIMD_INLINE inline
+#endif
+
+namespace dynd {
+
+/**
+ * The instruction sets that contiguous kernel loops are specialized for, in
+ * increasing order of width. ``simd_none`` disables the contiguous loops, so
+ * that kernels take their generic element by element path.
+ */
+enum simd_isa { simd_none, simd_sse2, simd_avx2, simd_avx512 };
+
+/**
+ * Returns the widest instruction set that the CPU supports.
+ */
+DYND_API simd_isa detected_simd_isa();
+
+/**
+ * Returns the instruction set that kernels currently use.
+ */
+DYND_API simd_isa get_simd_isa();
+
+/**
+ * Limits the instruction set that kernels use to ``isa``, or to what the CPU
+ * supports if that is narrower. Mostly useful for testing and benchmarking.
+ */
+DYND_API void set_simd_isa(simd_isa isa);
+
+namespace nd {
+  namespace detail {
+
+    template <typename T>
+    struct is_simd_type
+        : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+
+    template <typename... T>
+    struct are_simd_types;
+
+    template <>
+    struct are_simd_types<> : std::true_type {};
+
+    template <typename T0, typename... T>
+    struct are_simd_types<T0, T...>
+        : std::integral_constant<bool, is_simd_type<T0>::value && are_simd_types<T...>::value> {};
+
+    template <typename Func, typename R, typename A0>
+    DYND_SIMD_INLINE void unary_loop(R *dst, const A0 *src0, size_t count) {
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = Func::f(src0[i]);
+      }
+    }
+
+    template <typename Func, typename R, typename A0, typename A1>
+    DYND_SIMD_INLINE void binary_loop(R *dst, const A0 *src0, const A1 *src1, size_t count) {
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = Func::f(src0[i], src1[i]);
+      }
+    }
+
+    /**
+     * Runs ``Func::f`` over contiguous arrays of arithmetic types, with a
+     * clone of the loop for every instruction set in ``simd_isa``.
+     */
+    template <typename Func, typename R, typename... A>
+    struct contiguous_loop {
+      static void sse2(R *dst, const A *... src, size_t count) { run(dst, src..., count); }
+
+#ifdef DYND_SIMD_DISPATCH
+      DYND_SIMD_TARGET("avx2") static void avx2(R *dst, const A *... src, size_t count) { run(dst, src..., count); }
+
+      DYND_SIMD_TARGET("avx512f,avx512bw,avx512vl,avx512dq")
+      static void avx512(R *dst, const A *... src, size_t count) { run(dst, src..., count); }
+#endif
+
+      static void dispatch(R *dst, const A *... src, size_t count) {
+#ifdef DYND_SIMD_DISPATCH
+        switch (get_simd_isa()) {
+        case simd_avx512:
+          avx512(dst, src..., count);
+          return;
+        case simd_avx2:
+          avx2(dst, src..., count);
+          return;
+        default:
+          break;
+        }
+#endif
+        sse2(dst, src..., count);
+      }
+
+    private:
+      template <typename B0>
+      DYND_SIMD_INLINE static void run(R *dst, const B0 *src0, size_t count) {
+        unary_loop<Func>(dst, src0, count);
+      }
+
+      template <typename B0, typename B1>
+      DYND_SIMD_INLINE static void run(R *dst, const B0 *src0, const B1 *src1, size_t count) {
+        binary_loop<Func>(dst, src0, src1, count);
+      }
+    };
+
+    /**
+     * Calls ``contiguous_loop<Func, R, A...>`` if the kernel strides are all
+     * contiguous and SIMD loops are enabled, returning false otherwise.
+     */
+    template <typename Func, typename R, typename... A, size_t... I>
+    bool try_contiguous_loop(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                             size_t count, std::index_sequence<I...>) {
+      bool contiguous = dst_stride == static_cast<intptr_t>(sizeof(R));
+      for (bool c : {(src_stride[I] == static_cast<intptr_t>(sizeof(A)))...}) {
+        contiguous = contiguous && c;
+      }
+      if (!contiguous || get_simd_isa() == simd_none) {
+        return false;
+      }
+
+      contiguous_loop<Func, R, A...>::dispatch(reinterpret_cast<R *>(dst), reinterpret_cast<const A *>(src[I])...,
+                                               count);
+      return true;
+    }
+
+    /**
+     * Like ``try_contiguous_loop``, for a comparison ``Func::f`` of two values of
+     * type ``T`` that writes a bool1 (which is one byte) to ``dst``. Returns
+     * false if ``T`` is not an arithmetic type.
+     */
+    template <typename Func, typename T>
+    typename std::enable_if<is_simd_type<T>::value, bool>::type
+    try_contiguous_comparison(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride,
+                              size_t count) {
+      return try_contiguous_loop<Func, char, T, T>(dst, dst_stride, src, src_stride, count,
+                                                   std::index_sequence<0, 1>());
+    }
+
+    template <typename Func, typename T>
+    typename std::enable_if<!is_simd_type<T>::value, bool>::type
+    try_contiguous_comparison(char *DYND_UNUSED(dst), intptr_t DYND_UNUSED(dst_stride), char *const *DYND_UNUSED(src),
+                              const intptr_t *DYND_UNUSED(src_stride), size_t DYND_UNUSED(count)) {
+      return false;
+    }
+
+#define DYND_DEF_SIMD_COMPARISON(NAME, OP)                                                                             \
+  struct NAME {                                                                                                        \
+    template <typename T>                                                                                              \
+    static DYND_SIMD_INLINE char f(T a, T b) {                                                                         \
+      return a OP b;                                                                                                   \
+    }                                                                                                                  \
+  };
+
+    DYND_DEF_SIMD_COMPARISON(simd_equal, ==)
+    DYND_DEF_SIMD_COMPARISON(simd_not_equal, !=)
+    DYND_DEF_SIMD_COMPARISON(simd_less, <)
+    DYND_DEF_SIMD_COMPARISON(simd_less_equal, <=)
+    DYND_DEF_SIMD_COMPARISON(simd_greater, >)
+    DYND_DEF_SIMD_COMPARISON(simd_greater_equal, >=)
+
+#undef DYND_DEF_SIMD_COMPARISON
+
+  } // namespace dynd::nd::detail
+} // namespace dynd::nd
+} // namespace dynd
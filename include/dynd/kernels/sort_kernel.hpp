@@ -5,8 +5,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
 #include <dynd/bytes.hpp>
 #include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/parallel.hpp>
 
 namespace dynd {
 namespace nd {
@@ -37,5 +43,206 @@ namespace nd {
     }
   };
 
+  namespace detail {
+
+    /**
+     * The ascending order used to sort builtin values, which is ``<`` except
+     * that NaNs go last instead of breaking the strict weak ordering.
+     */
+    template <typename T>
+    struct sort_less {
+      bool operator()(T lhs, T rhs) const { return lhs < rhs; }
+    };
+
+    template <typename T>
+    struct sort_less_float {
+      bool operator()(T lhs, T rhs) const { return lhs < rhs || (rhs != rhs && lhs == lhs); }
+    };
+
+    template <>
+    struct sort_less<float> : sort_less_float<float> {};
+
+    template <>
+    struct sort_less<double> : sort_less_float<double> {};
+
+    /**
+     * Maps values to unsigned keys that sort in the same order as
+     * ``sort_less``, for a radix sort.
+     */
+    template <typename T, typename Enable = void>
+    struct radix_key;
+
+    template <typename T>
+    struct radix_key<T, std::enable_if_t<std::is_integral<T>::value>> {
+      typedef std::make_unsigned_t<T> type;
+
+      static type get(T value) {
+        return std::is_signed<T>::value ? (static_cast<type>(value) ^ (type(1) << (8 * sizeof(T) - 1)))
+                                        : static_cast<type>(value);
+      }
+    };
+
+    template <typename T>
+    struct radix_key<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+      typedef std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> type;
+
+      static type get(T value) {
+        if (value != value) {
+          return ~type(0);
+        }
+
+        type bits;
+        memcpy(&bits, &value, sizeof(T));
+        const type sign = type(1) << (8 * sizeof(T) - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+      }
+    };
+
+    /**
+     * Sorts ``data`` with a least significant digit radix sort on bytes,
+     * using ``buffer`` (of the same size) as scratch space. Passes over a byte
+     * that is the same for every key are skipped.
+     */
+    template <typename T>
+    void radix_sort(T *data, T *buffer, size_t size) {
+      typedef radix_key<T> key;
+
+      size_t count[sizeof(T)][256] = {};
+      for (size_t i = 0; i < size; ++i) {
+        typename key::type k = key::get(data[i]);
+        for (size_t j = 0; j < sizeof(T); ++j) {
+          ++count[j][(k >> (8 * j)) & 0xFF];
+        }
+      }
+
+      T *src = data, *dst = buffer;
+      for (size_t j = 0; j < sizeof(T); ++j) {
+        if (count[j][(key::get(data[0]) >> (8 * j)) & 0xFF] == size) {
+          continue;
+        }
+
+        size_t offset[256];
+        size_t total = 0;
+        for (size_t b = 0; b < 256; ++b) {
+          offset[b] = total;
+          total += count[j][b];
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+          dst[offset[(key::get(src[i]) >> (8 * j)) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        memcpy(data, src, size * sizeof(T));
+      }
+    }
+
+    /**
+     * Below this size, std::sort beats the radix sort.
+     */
+    const size_t radix_sort_threshold = 256;
+
+    /**
+     * From this size on, sorts may be split over threads.
+     */
+    const size_t parallel_sort_threshold = 1 << 16;
+
+    template <typename T>
+    void sort_contiguous(T *data, T *buffer, size_t size) {
+      if (size < radix_sort_threshold) {
+        std::sort(data, data + size, sort_less<T>());
+      } else {
+        radix_sort(data, buffer, size);
+      }
+    }
+
+    /**
+     * Sorts ``nthreads`` chunks of ``data`` concurrently, and then merges them
+     * pairwise, with the merges of each round running concurrently.
+     */
+    template <typename T>
+    void parallel_sort(T *data, T *buffer, size_t size, size_t nthreads) {
+      size_t nchunks = nthreads;
+      std::vector<size_t> bound(nchunks + 1);
+      for (size_t i = 0; i <= nchunks; ++i) {
+        bound[i] = size * i / nchunks;
+      }
+
+      parallel_for(nchunks, 1, nthreads, [&](size_t begin, size_t end, size_t DYND_UNUSED(worker)) {
+        for (size_t i = begin; i < end; ++i) {
+          sort_contiguous(data + bound[i], buffer + bound[i], bound[i + 1] - bound[i]);
+        }
+      });
+
+      T *src = data, *dst = buffer;
+      for (size_t width = 1; width < nchunks; width *= 2) {
+        size_t npairs = (nchunks + 2 * width - 1) / (2 * width);
+        parallel_for(npairs, 1, nthreads, [&](size_t begin, size_t end, size_t DYND_UNUSED(worker)) {
+          for (size_t i = begin; i < end; ++i) {
+            size_t lo = bound[2 * i * width];
+            size_t mid = bound[std::min(2 * i * width + width, nchunks)];
+            size_t hi = bound[std::min(2 * i * width + 2 * width, nchunks)];
+            std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, sort_less<T>());
+          }
+        });
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        memcpy(data, src, size * sizeof(T));
+      }
+    }
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Sorts a dimension of builtin integers or floats in place without going
+   * through a comparison kernel. Contiguous data is sorted where it is, and
+   * strided data is gathered into a contiguous buffer first.
+   */
+  template <typename T>
+  struct typed_sort_kernel : base_strided_kernel<typed_sort_kernel<T>, 1> {
+    const intptr_t m_size;
+    const intptr_t m_stride;
+    const size_t m_nthreads;
+    std::vector<T> m_buffer;
+
+    typed_sort_kernel(intptr_t size, intptr_t stride, size_t nthreads)
+        : m_size(size), m_stride(stride), m_nthreads(nthreads) {}
+
+    void single(char *DYND_UNUSED(dst), char *const *src) {
+      size_t size = m_size;
+      if (size < 2) {
+        return;
+      }
+
+      bool contiguous = m_stride == static_cast<intptr_t>(sizeof(T));
+      m_buffer.resize(contiguous ? size : (2 * size));
+
+      T *data = reinterpret_cast<T *>(src[0]);
+      T *buffer = m_buffer.data();
+      if (!contiguous) {
+        for (size_t i = 0; i < size; ++i) {
+          memcpy(buffer + size + i, src[0] + i * m_stride, sizeof(T));
+        }
+        data = buffer + size;
+      }
+
+      if (m_nthreads > 1 && size >= detail::parallel_sort_threshold && !in_parallel_region()) {
+        detail::parallel_sort(data, buffer, size, m_nthreads);
+      } else {
+        detail::sort_contiguous(data, buffer, size);
+      }
+
+      if (!contiguous) {
+        for (size_t i = 0; i < size; ++i) {
+          memcpy(src[0] + i * m_stride, data + i, sizeof(T));
+        }
+      }
+    }
+  };
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -5,39 +5,160 @@
 
 #pragma once
 
-#include <dynd/bytes.hpp>
-#include <dynd/kernels/base_kernel.hpp>
+#include <cstring>
+#include <vector>
+
+#include <dynd/kernels/base_strided_kernel.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    inline uint64_t unique_mix(uint64_t x) {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return x;
+    }
+
+    /**
+     * The hash and equality that ``unique`` uses for values of type ``T``.
+     */
+    template <typename T>
+    struct unique_traits {
+      static uint64_t hash(const T &value) { return unique_mix(static_cast<uint64_t>(value)); }
+
+      static bool equal(const T &lhs, const T &rhs) { return lhs == rhs; }
+    };
+
+    // Zeros of either sign are the same value, and so are all NaNs
+    template <typename T>
+    struct unique_float_traits {
+      static uint64_t hash(const T &value) {
+        if (value == 0) {
+          return 0;
+        }
+        if (value != value) {
+          return 1;
+        }
+
+        uint64_t bits = 0;
+        memcpy(&bits, &value, sizeof(T));
+        return unique_mix(bits);
+      }
+
+      static bool equal(const T &lhs, const T &rhs) { return lhs == rhs || (lhs != lhs && rhs != rhs); }
+    };
+
+    template <>
+    struct unique_traits<float> : unique_float_traits<float> {};
+
+    template <>
+    struct unique_traits<double> : unique_float_traits<double> {};
+
+    template <>
+    struct unique_traits<string> {
+      static uint64_t hash(const string &value) {
+        // FNV-1a
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (const char *p = value.begin(), *end = value.end(); p != end; ++p) {
+          h = (h ^ static_cast<unsigned char>(*p)) * 0x100000001b3ULL;
+        }
+        return unique_mix(h);
+      }
+
+      static bool equal(const string &lhs, const string &rhs) {
+        return lhs.size() == rhs.size() && memcmp(lhs.begin(), rhs.begin(), lhs.size()) == 0;
+      }
+    };
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Finds the distinct values of a dimension with an open addressing hash
+   * table, in the order of their first occurrence. The values go to a var
+   * dimension of the destination, and optionally the number of occurrences of
+   * each value and, for every element, the index of its value.
+   *
+   * The fields are at the given data offsets of the destination, which is
+   * either just the var dimension of values or a struct. A null counts arrmeta
+   * or a negative inverse offset leaves that field out.
+   */
+  template <typename T>
+  struct unique_kernel : base_strided_kernel<unique_kernel<T>, 1> {
+    typedef detail::unique_traits<T> traits;
+
+    const intptr_t m_size;
+    const intptr_t m_src_stride;
+    const ndt::var_dim_type::metadata_type *m_values_arrmeta;
+    const intptr_t m_values_offset;
+    const ndt::var_dim_type::metadata_type *m_counts_arrmeta;
+    const intptr_t m_counts_offset;
+    const intptr_t m_inverse_stride;
+    const intptr_t m_inverse_offset;
+    // The table holds indices into m_first, with -1 for an empty slot
+    std::vector<intptr_t> m_table;
+    std::vector<const T *> m_first;
+    std::vector<int64_t> m_counts;
+
+    unique_kernel(intptr_t size, intptr_t src_stride, const char *values_arrmeta, intptr_t values_offset,
+                  const char *counts_arrmeta, intptr_t counts_offset, intptr_t inverse_stride, intptr_t inverse_offset)
+        : m_size(size), m_src_stride(src_stride),
+          m_values_arrmeta(reinterpret_cast<const ndt::var_dim_type::metadata_type *>(values_arrmeta)),
+          m_values_offset(values_offset),
+          m_counts_arrmeta(reinterpret_cast<const ndt::var_dim_type::metadata_type *>(counts_arrmeta)),
+          m_counts_offset(counts_offset), m_inverse_stride(inverse_stride), m_inverse_offset(inverse_offset) {}
+
+    void single(char *dst, char *const *src) {
+      // Keep the load factor at or below one half
+      size_t capacity = 16;
+      while (capacity < 2 * static_cast<size_t>(m_size)) {
+        capacity *= 2;
+      }
+      size_t mask = capacity - 1;
+      m_table.assign(capacity, -1);
+      m_first.clear();
+      m_counts.clear();
+
+      for (intptr_t i = 0; i < m_size; ++i) {
+        const T &value = *reinterpret_cast<const T *>(src[0] + i * m_src_stride);
+        size_t slot = static_cast<size_t>(traits::hash(value)) & mask;
+        while (m_table[slot] != -1 && !traits::equal(*m_first[m_table[slot]], value)) {
+          slot = (slot + 1) & mask;
+        }
+
+        if (m_table[slot] == -1) {
+          m_table[slot] = m_first.size();
+          m_first.push_back(&value);
+          m_counts.push_back(0);
+        }
+        ++m_counts[m_table[slot]];
+
+        if (m_inverse_offset >= 0) {
+          *reinterpret_cast<int64_t *>(dst + m_inverse_offset + i * m_inverse_stride) = m_table[slot];
+        }
+      }
+
+      size_t count = m_first.size();
+      ndt::var_dim_type::data_type *values = reinterpret_cast<ndt::var_dim_type::data_type *>(dst + m_values_offset);
+      values->begin = m_values_arrmeta->blockref->alloc(count);
+      values->size = count;
+      for (size_t j = 0; j < count; ++j) {
+        *reinterpret_cast<T *>(values->begin + j * m_values_arrmeta->stride) = *m_first[j];
+      }
 
-  struct unique_kernel : base_kernel<unique_kernel> {
-    const intptr_t src0_size;
-    const intptr_t src0_stride;
-    const intptr_t src0_element_data_size;
-
-    unique_kernel(intptr_t src0_size, intptr_t src0_stride, size_t src0_element_data_size)
-        : src0_size(src0_size), src0_stride(src0_stride), src0_element_data_size(src0_element_data_size) {}
-
-    ~unique_kernel() { get_child()->destroy(); }
-
-    void call(array *DYND_UNUSED(dst), const array *src) {
-      kernel_prefix *child = get_child();
-      size_t new_size =
-          (std::unique(strided_iterator(src[0].data(), src0_element_data_size, src0_stride),
-                       strided_iterator(src[0].data() + src0_size * src0_stride, src0_element_data_size, src0_stride),
-                       [child](char *lhs, char *rhs) {
-                         bool1 dst;
-                         char *src[2] = {lhs, rhs};
-                         child->single(reinterpret_cast<char *>(&dst), src);
-                         return dst;
-                       }) -
-           src[0].data()) /
-          src0_stride;
-
-//      src[0]->set_type(
-  //        ndt::make_fixed_dim(new_size, src[0]->get_type().extended<ndt::fixed_dim_type>()->get_element_type()));
-      reinterpret_cast<size_stride_t *>(src[0]->metadata())->dim_size = new_size;
+      if (m_counts_arrmeta != nullptr) {
+        ndt::var_dim_type::data_type *counts = reinterpret_cast<ndt::var_dim_type::data_type *>(dst + m_counts_offset);
+        counts->begin = m_counts_arrmeta->blockref->alloc(count);
+        counts->size = count;
+        for (size_t j = 0; j < count; ++j) {
+          *reinterpret_cast<int64_t *>(counts->begin + j * m_counts_arrmeta->stride) = m_counts[j];
+        }
+      }
     }
   };
 
@@ -30,6 +30,23 @@ namespace nd {
     default_access_flags = read_access_flag | write_access_flag,
   };
 
+  /**
+   * Hints about how a memory-mapped file will be used. They are advice to
+   * the operating system, and are ignored where it does not support them.
+   */
+  enum memmap_flags {
+    /** The pages will be read in order, so read ahead aggressively (MADV_SEQUENTIAL) */
+    memmap_sequential_flag = 0x01,
+    /** The pages will be read in no particular order, so do not read ahead (MADV_RANDOM) */
+    memmap_random_flag = 0x02,
+    /** The pages will be needed soon, so start reading them in the background (MADV_WILLNEED) */
+    memmap_willneed_flag = 0x04,
+    /** Read the whole mapping in before returning, so that accessing it never faults (MAP_POPULATE) */
+    memmap_populate_flag = 0x08,
+    /** Back the mapping with transparent huge pages where possible (MADV_HUGEPAGE) */
+    memmap_huge_pages_flag = 0x10
+  };
+
   /**
    * This structure is the start of any nd::array arrmeta. The
    * arrmeta after this structure is determined by the type
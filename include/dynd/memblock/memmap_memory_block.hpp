@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <cerrno>
+#include <cstring>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 #ifdef _WIN32
@@ -21,6 +24,7 @@
 #endif
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/buffer_memory_block.hpp>
 
 namespace dynd {
 
@@ -67,6 +71,8 @@ namespace nd {
    *
    * \param filename  The filename of the file to memory map.
    * \param access  A combination of write_access_flag, read_access_flag, immutable_access_flag.
+   *                The file is opened and mapped for writing if write_access_flag is set, and
+   *                changes are written back to it.
    * \param out_pointer  This is the pointer to the mapped memory.
    * \param out_size  This is the size of the mapped memory. Note that the size may be different
    *                  than requested by begin/end, because this function uses Python semantics to
@@ -79,6 +85,7 @@ namespace nd {
    *             (default end of the file). This value may be
    *             negative, in which case it is interpreted as an offset from the
    *             end of the file.
+   * \param flags  A combination of the memmap_flags hints.
    */
   class memmap_memory_block : public base_memory_block {
     // Parameters used to construct the memory block
@@ -97,10 +104,10 @@ namespace nd {
     intptr_t m_mapOffset;
 
   public:
-    memmap_memory_block(const std::string &filename, uint32_t DYND_UNUSED(access), char **out_pointer,
-                        intptr_t *out_size, intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max())
+    memmap_memory_block(const std::string &filename, uint32_t access, char **out_pointer, intptr_t *out_size,
+                        intptr_t begin = 0, intptr_t end = std::numeric_limits<intptr_t>::max(), uint32_t flags = 0)
         : m_filename(filename), m_begin(begin), m_end(end) {
-      bool readwrite = false; // ((access & nd::write_access_flag) == nd::write_access_flag);
+      bool readwrite = ((access & nd::write_access_flag) == nd::write_access_flag);
 #ifdef WIN32
       // TODO: This function isn't quite exception-safe, use a smart pointer for the handles to fix.
 
@@ -111,9 +118,16 @@ namespace nd {
       sysGran = sysInfo.dwAllocationGranularity;
 
       // Open the file using the windows API
+      DWORD file_flags = FILE_ATTRIBUTE_NORMAL;
+      if (flags & memmap_sequential_flag) {
+        file_flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+      }
+      if (flags & memmap_random_flag) {
+        file_flags |= FILE_FLAG_RANDOM_ACCESS;
+      }
       m_hFile = CreateFile(m_filename.c_str(), GENERIC_READ | (readwrite ? GENERIC_WRITE : 0), FILE_SHARE_READ, NULL,
-                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-      if (m_hFile == NULL) {
+                           OPEN_EXISTING, file_flags, NULL);
+      if (m_hFile == INVALID_HANDLE_VALUE) {
         std::stringstream ss;
         ss << "failed to open file \"" << m_filename << "\" for memory mapping";
         throw std::runtime_error(ss.str());
@@ -179,6 +193,7 @@ namespace nd {
 #endif
       struct stat st;
       if (fstat(m_fd, &st) == -1) {
+        close(m_fd);
         std::stringstream ss;
         ss << "failed to stat file \"" << m_filename << "\" for memory mapping";
         throw std::runtime_error(ss.str());
@@ -196,7 +211,21 @@ namespace nd {
       m_mapOffset = begin - mapbegin;
       intptr_t mapsize = end - mapbegin;
 
-      m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0), MAP_SHARED, m_fd, mapbegin);
+      if (mapsize == 0) {
+        // Mapping nothing fails, so an empty range has no mapping
+        m_mapPointer = NULL;
+        *out_pointer = NULL;
+        *out_size = 0;
+        return;
+      }
+
+      int mmap_flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+      if (flags & memmap_populate_flag) {
+        mmap_flags |= MAP_POPULATE;
+      }
+#endif
+      m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0), mmap_flags, m_fd, mapbegin);
       if (m_mapPointer == (char *)MAP_FAILED) {
         close(m_fd);
         std::stringstream ss;
@@ -204,19 +233,79 @@ namespace nd {
         throw std::runtime_error(ss.str());
       }
 
+      // The hints are only advice, so failures are ignored
+      if (flags & memmap_sequential_flag) {
+        (void)madvise(m_mapPointer, mapsize, MADV_SEQUENTIAL);
+      }
+      if (flags & memmap_random_flag) {
+        (void)madvise(m_mapPointer, mapsize, MADV_RANDOM);
+      }
+      if (flags & memmap_willneed_flag) {
+        (void)madvise(m_mapPointer, mapsize, MADV_WILLNEED);
+      }
+#ifdef MADV_HUGEPAGE
+      if (flags & memmap_huge_pages_flag) {
+        (void)madvise(m_mapPointer, mapsize, MADV_HUGEPAGE);
+      }
+#endif
+
       *out_pointer = m_mapPointer + m_mapOffset;
       *out_size = end - begin;
 #endif
     }
 
+    /**
+     * Writes the modified pages in [begin, end) of the mapping back to the
+     * file. With ``async`` set, this only schedules the writes. The range is
+     * relative to the start of the mapped data.
+     */
+    void flush(intptr_t begin, intptr_t end, bool async = false) {
+      clip_begin_end(m_end - m_begin, begin, end);
+      if (begin == end) {
+        return;
+      }
+
+#ifdef WIN32
+      if (!FlushViewOfFile(m_mapPointer + m_mapOffset + begin, end - begin) || (!async && !FlushFileBuffers(m_hFile))) {
+        std::stringstream ss;
+        ss << "failed to flush memory mapped file \"" << m_filename << "\"";
+        throw std::runtime_error(ss.str());
+      }
+#else
+      // msync needs a page aligned address
+      intptr_t pageSize = sysconf(_SC_PAGE_SIZE);
+      intptr_t syncbegin = ((m_mapOffset + begin) / pageSize) * pageSize;
+      if (msync(m_mapPointer + syncbegin, m_mapOffset + end - syncbegin, async ? MS_ASYNC : MS_SYNC) == -1) {
+        std::stringstream ss;
+        ss << "failed to flush memory mapped file \"" << m_filename << "\": " << strerror(errno);
+        throw std::runtime_error(ss.str());
+      }
+#endif
+    }
+
+    /**
+     * Whether ``ptr`` points into the mapped data.
+     */
+    bool contains(const char *ptr) const {
+      return m_mapPointer != NULL && ptr >= m_mapPointer + m_mapOffset &&
+             ptr < m_mapPointer + m_mapOffset + (m_end - m_begin);
+    }
+
+    /**
+     * The offset of ``ptr`` from the start of the mapped data.
+     */
+    intptr_t get_offset(const char *ptr) const { return ptr - (m_mapPointer + m_mapOffset); }
+
     ~memmap_memory_block() {
 #ifdef WIN32
       UnmapViewOfFile(m_mapPointer);
       CloseHandle(m_hMapFile);
       CloseHandle(m_hFile);
 #else
-      intptr_t mapsize = m_end - m_begin + m_mapOffset;
-      munmap((void *)m_mapPointer, mapsize);
+      if (m_mapPointer != NULL) {
+        intptr_t mapsize = m_end - m_begin + m_mapOffset;
+        munmap((void *)m_mapPointer, mapsize);
+      }
       close(m_fd);
 #endif
     }
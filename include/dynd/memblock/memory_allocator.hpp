@@ -0,0 +1,170 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * The interface through which memory blocks like pod_memory_block and
+   * objectarray_memory_block get the chunks of memory that they dole out.
+   * Every chunk is returned to the allocator that it came from, together with
+   * the size that it was requested with.
+   *
+   * Memory returned by an allocator is suitably aligned for any builtin type.
+   */
+  class DYNDT_API base_memory_allocator {
+  public:
+    virtual ~base_memory_allocator();
+
+    /**
+     * Allocates ``size`` bytes, throwing std::bad_alloc on failure.
+     */
+    virtual char *allocate(size_t size) = 0;
+
+    /**
+     * Returns memory that was allocated with ``allocate(size)``.
+     */
+    virtual void deallocate(char *ptr, size_t size) = 0;
+
+    /**
+     * Grows or shrinks memory that was allocated with ``allocate(size)`` to
+     * ``new_size`` bytes, preserving its first ``used_size`` bytes. The memory
+     * may be moved. The default allocates, copies and deallocates.
+     */
+    virtual char *reallocate(char *ptr, size_t size, size_t new_size, size_t used_size);
+
+    /**
+     * A short name for the allocator, used by debug_print.
+     */
+    virtual const char *name() const = 0;
+  };
+
+  /**
+   * Allocates every chunk with malloc and frees it with free. Growing the most
+   * recent chunk uses realloc, which can often extend it in place.
+   */
+  class DYNDT_API malloc_memory_allocator : public base_memory_allocator {
+  public:
+    char *allocate(size_t size);
+    void deallocate(char *ptr, size_t size);
+    char *reallocate(char *ptr, size_t size, size_t new_size, size_t used_size);
+    const char *name() const { return "malloc"; }
+  };
+
+  /**
+   * Rounds chunk sizes up to a power of two between 256 bytes and 1 MB, and
+   * keeps freed chunks of each size class in a small per-thread cache from
+   * which later allocations are served without a lock or a call into the
+   * system allocator. Larger chunks go straight to malloc.
+   *
+   * The cache of each size class is bounded, so a thread holds on to at most
+   * a few megabytes of freed memory. Caches are released when their thread
+   * exits.
+   */
+  class DYNDT_API pool_memory_allocator : public base_memory_allocator {
+  public:
+    static const size_t min_class_size = 256;
+    static const size_t max_class_size = 1 << 20;
+
+    char *allocate(size_t size);
+    void deallocate(char *ptr, size_t size);
+    char *reallocate(char *ptr, size_t size, size_t new_size, size_t used_size);
+    const char *name() const { return "pool"; }
+  };
+
+  /**
+   * Hands out memory by bumping a pointer through large slabs. Deallocating
+   * does nothing, and all of the memory is given back at once by ``release``
+   * or when the arena is destroyed, which makes it a good fit for many
+   * short-lived ragged arrays that die together.
+   *
+   * Memory blocks keep the allocator they were created with alive, but the
+   * caller must not ``release`` an arena while arrays that use it are alive.
+   */
+  class DYNDT_API arena_memory_allocator : public base_memory_allocator {
+    std::mutex m_mutex;
+    size_t m_slab_size;
+    std::vector<char *> m_slabs;
+    char *m_current, *m_end;
+    size_t m_reserved_size;
+
+  public:
+    arena_memory_allocator(size_t slab_size = 1 << 20);
+
+    ~arena_memory_allocator();
+
+    char *allocate(size_t size);
+    void deallocate(char *ptr, size_t size);
+    char *reallocate(char *ptr, size_t size, size_t new_size, size_t used_size);
+    const char *name() const { return "arena"; }
+
+    /**
+     * The number of bytes that the arena has reserved from the system.
+     */
+    size_t get_reserved_size();
+
+    /**
+     * Frees all the memory handed out by the arena.
+     */
+    void release();
+  };
+
+  /**
+   * Returns the shared malloc allocator.
+   */
+  DYNDT_API const std::shared_ptr<base_memory_allocator> &malloc_allocator();
+
+  /**
+   * Returns the shared pool allocator.
+   */
+  DYNDT_API const std::shared_ptr<base_memory_allocator> &pool_allocator();
+
+  /**
+   * Returns the allocator that new memory blocks use, which is the malloc
+   * allocator unless it has been changed. The pool allocator is opt-in.
+   */
+  DYNDT_API std::shared_ptr<base_memory_allocator> get_default_memory_allocator();
+
+  /**
+   * Sets the allocator that new memory blocks use. Existing memory blocks
+   * keep the allocator they were created with.
+   */
+  DYNDT_API void set_default_memory_allocator(const std::shared_ptr<base_memory_allocator> &allocator);
+
+  /**
+   * Allocation statistics of a single memory block.
+   */
+  struct memory_block_stats {
+    /** The number of chunks requested from the allocator */
+    size_t chunk_count = 0;
+    /** The number of bytes in those chunks */
+    size_t chunk_bytes = 0;
+    /** The number of calls to alloc */
+    size_t alloc_count = 0;
+    /** The number of calls to resize */
+    size_t resize_count = 0;
+    /** The number of bytes that resize had to copy to a new chunk */
+    size_t resize_copy_bytes = 0;
+
+    void debug_print(std::ostream &o, const std::string &indent, const base_memory_allocator &allocator) const {
+      o << indent << " allocator: " << allocator.name() << "\n";
+      o << indent << " chunks: " << chunk_count << " (" << chunk_bytes << " bytes)\n";
+      o << indent << " allocs: " << alloc_count << ", resizes: " << resize_count << " (" << resize_copy_bytes
+        << " bytes copied)\n";
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
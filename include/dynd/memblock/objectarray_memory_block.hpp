@@ -9,6 +9,7 @@
 #include <string>
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 #include <dynd/type.hpp>
 
 namespace dynd {
@@ -31,6 +32,7 @@ namespace nd {
    *                for each element. This would be typically set to the value for
    *                get_default_data_size() corresponding to default-constructed arrmeta.
    * \param initial_count  The number of elements to allocate at the start.
+   * \param allocator  The allocator to get memory from.
    */
   class objectarray_memory_block : public base_memory_block {
     ndt::type m_dt;
@@ -39,14 +41,18 @@ namespace nd {
     intptr_t m_stride;
     size_t m_total_allocated_count;
     bool m_finalized;
-    /** The malloc'd memory */
+    /** The allocator that the memory comes from */
+    std::shared_ptr<base_memory_allocator> m_allocator;
+    /** The allocated memory */
     std::vector<memory_chunk> m_memory_handles;
+    memory_block_stats m_stats;
 
   public:
     objectarray_memory_block(const ndt::type &dt, size_t arrmeta_size, const char *arrmeta, intptr_t stride,
-                             intptr_t initial_count)
+                             intptr_t initial_count,
+                             const std::shared_ptr<base_memory_allocator> &allocator = get_default_memory_allocator())
         : m_dt(dt), arrmeta_size(arrmeta_size), m_arrmeta(arrmeta), m_stride(stride), m_total_allocated_count(0),
-          m_finalized(false), m_memory_handles() {
+          m_finalized(false), m_allocator(allocator), m_memory_handles() {
       if ((dt.get_flags() & type_flag_destructor) == 0) {
         std::stringstream ss;
         ss << "Cannot create objectarray memory block with dynd type " << dt;
@@ -60,7 +66,7 @@ namespace nd {
       for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
         memory_chunk &mc = m_memory_handles[i];
         m_dt.extended()->data_destruct_strided(m_arrmeta + arrmeta_size, mc.memory, m_stride, mc.used_count);
-        free(mc.memory);
+        m_allocator->deallocate(mc.memory, m_stride * mc.capacity_count);
       }
     }
 
@@ -69,20 +75,19 @@ namespace nd {
      * more. Adds it to the memory handles vector.
      */
     void append_memory(intptr_t count) {
-      m_memory_handles.push_back(memory_chunk());
-      memory_chunk &mc = m_memory_handles.back();
+      m_memory_handles.reserve(m_memory_handles.size() + 1);
+      memory_chunk mc;
       mc.used_count = 0;
       mc.capacity_count = count;
-      char *memory = reinterpret_cast<char *>(malloc(m_stride * count));
-      mc.memory = memory;
-      if (memory == NULL) {
-        m_memory_handles.pop_back();
-        throw std::bad_alloc();
-      }
+      mc.memory = m_allocator->allocate(m_stride * count);
+      m_memory_handles.push_back(mc);
       m_total_allocated_count += count;
+      ++m_stats.chunk_count;
+      m_stats.chunk_bytes += m_stride * count;
     }
 
     char *alloc(size_t count) {
+      ++m_stats.alloc_count;
       //    cout << "allocating " << size_bytes << " of memory with alignment " << alignment << endl;
       // Allocate new POD memory of the requested size and alignment
       memory_chunk *mc = &m_memory_handles.back();
@@ -106,26 +111,37 @@ namespace nd {
     }
 
     char *resize(char *previous_allocated, size_t count) {
+      ++m_stats.resize_count;
       memory_chunk *mc = &m_memory_handles.back();
       size_t previous_index = (previous_allocated - mc->memory) / m_stride;
       size_t previous_count = mc->used_count - previous_index;
       char *result = previous_allocated;
 
-      if (mc->capacity_count - previous_index < count) {
+      if (mc->capacity_count < count && previous_allocated == mc->memory) {
+        // If the memory being resized is all that is in the last chunk, grow
+        // the chunk, which the allocator may be able to do in place
+        size_t capacity_count = std::max(m_total_allocated_count, count);
+        result = m_allocator->reallocate(mc->memory, m_stride * mc->capacity_count, m_stride * capacity_count,
+                                         m_stride * previous_count);
+        if (result != mc->memory) {
+          m_stats.resize_copy_bytes += m_stride * previous_count;
+        }
+        m_total_allocated_count += capacity_count - mc->capacity_count;
+        m_stats.chunk_bytes += m_stride * (capacity_count - mc->capacity_count);
+        mc->memory = result;
+        mc->capacity_count = capacity_count;
+        mc->used_count = count;
+      } else if (mc->capacity_count - previous_index < count) {
         append_memory(std::max(m_total_allocated_count, count));
+        // Appending may have moved the chunks
+        mc = &m_memory_handles[m_memory_handles.size() - 2];
         memory_chunk *new_mc = &m_memory_handles.back();
         // Move the old memory to the newly allocated block
         if (previous_count > 0) {
           // Subtract the previously used memory from the old chunk's count
           mc->used_count -= previous_count;
-          memcpy(new_mc->memory, previous_allocated, previous_count);
-          // If the old memory only had the memory being resized,
-          // free it completely.
-          if (previous_allocated == mc->memory) {
-            free(mc->memory);
-            // Remove the second-last element of the vector
-            m_memory_handles.erase(m_memory_handles.begin() + m_memory_handles.size() - 2);
-          }
+          memcpy(new_mc->memory, previous_allocated, m_stride * previous_count);
+          m_stats.resize_copy_bytes += m_stride * previous_count;
         }
         mc = &m_memory_handles.back();
         result = mc->memory;
@@ -146,7 +162,7 @@ namespace nd {
         // Zero-init the new memory
         intptr_t new_count = count - (intptr_t)previous_count;
         if (new_count > 0) {
-          memset(mc->memory + m_stride * previous_count, 0, m_stride * new_count);
+          memset(result + m_stride * previous_count, 0, m_stride * new_count);
         }
       } else {
         // TODO: Add a default data constructor to base_type
@@ -167,7 +183,7 @@ namespace nd {
         for (size_t i = 0, i_end = m_memory_handles.size() - 1; i != i_end; ++i) {
           memory_chunk &mc = m_memory_handles[i];
           m_dt.extended()->data_destruct_strided(m_arrmeta, mc.memory, m_stride, mc.used_count);
-          free(mc.memory);
+          m_allocator->deallocate(mc.memory, m_stride * mc.capacity_count);
         }
         m_memory_handles.front() = m_memory_handles.back();
         m_memory_handles.resize(1);
@@ -188,6 +204,7 @@ namespace nd {
       } else {
         o << indent << " finalized count: " << m_total_allocated_count << "\n";
       }
+      m_stats.debug_print(o, indent, *m_allocator);
       o << indent << "------" << std::endl;
     }
   };
@@ -9,6 +9,7 @@
 #include <string>
 
 #include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 #include <dynd/type.hpp>
 
 namespace dynd {
@@ -19,22 +20,28 @@ namespace nd {
     size_t data_size;
     intptr_t data_alignment;
     intptr_t m_total_allocated_capacity;
-    /** The malloc'd memory */
-    std::vector<char *> m_memory_handles;
-    /** The current malloc'd memory being doled out */
+    /** The allocator that the memory comes from */
+    std::shared_ptr<base_memory_allocator> m_allocator;
+    /** The allocated memory, with the size of each chunk */
+    std::vector<std::pair<char *, intptr_t>> m_memory_handles;
+    /** The current allocated memory being doled out */
     char *m_memory_begin, *m_memory_current, *m_memory_end;
+    memory_block_stats m_stats;
 
-    pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048)
-        : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0), m_memory_handles() {
+    pod_memory_block(size_t data_size, intptr_t data_alignment, intptr_t initial_capacity_bytes = 2048,
+                     const std::shared_ptr<base_memory_allocator> &allocator = get_default_memory_allocator())
+        : data_size(data_size), data_alignment(data_alignment), m_total_allocated_capacity(0), m_allocator(allocator),
+          m_memory_handles() {
       append_memory(initial_capacity_bytes);
     }
 
-    pod_memory_block(const ndt::type &tp, intptr_t initial_capacity_bytes = 2048)
-        : pod_memory_block(tp.get_default_data_size(), tp.get_data_alignment(), initial_capacity_bytes) {}
+    pod_memory_block(const ndt::type &tp, intptr_t initial_capacity_bytes = 2048,
+                     const std::shared_ptr<base_memory_allocator> &allocator = get_default_memory_allocator())
+        : pod_memory_block(tp.get_default_data_size(), tp.get_data_alignment(), initial_capacity_bytes, allocator) {}
 
     ~pod_memory_block() {
       for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
-        free(m_memory_handles[i]);
+        m_allocator->deallocate(m_memory_handles[i].first, m_memory_handles[i].second);
       }
     }
 
@@ -43,20 +50,19 @@ namespace nd {
      * more. Adds it to the memory handles vector.
      */
     void append_memory(intptr_t capacity_bytes) {
-      m_memory_handles.push_back(NULL);
-      m_memory_begin = reinterpret_cast<char *>(malloc(capacity_bytes));
-      m_memory_handles.back() = m_memory_begin;
-      if (m_memory_begin == NULL) {
-        m_memory_handles.pop_back();
-        throw std::bad_alloc();
-      }
+      m_memory_handles.reserve(m_memory_handles.size() + 1);
+      m_memory_begin = m_allocator->allocate(capacity_bytes);
+      m_memory_handles.emplace_back(m_memory_begin, capacity_bytes);
       m_memory_current = m_memory_begin;
       m_memory_end = m_memory_current + capacity_bytes;
       m_total_allocated_capacity += capacity_bytes;
+      ++m_stats.chunk_count;
+      m_stats.chunk_bytes += capacity_bytes;
     }
 
     char *alloc(size_t count) {
       intptr_t size_bytes = count * data_size;
+      ++m_stats.alloc_count;
 
       //    cout << "allocating " << size_bytes << " of memory with alignment " << alignment << endl;
       // Allocate new POD memory of the requested size and alignment
@@ -88,12 +94,30 @@ namespace nd {
       //    cout << "memory state before " << (void *)emb->m_memory_begin << " / " << (void *)emb->m_memory_current << "
       //    /
       // " << (void *)emb->m_memory_end << endl;
+      ++m_stats.resize_count;
       char **inout_end = &m_memory_current;
       char *end = inout_begin + size_bytes;
       if (end <= m_memory_end) {
         // If it fits, just adjust the current allocation point
         m_memory_current = end;
         *inout_end = end;
+      } else if (inout_begin == m_memory_begin) {
+        // If the memory being resized is all that is in the current chunk,
+        // grow the chunk, which the allocator may be able to do in place
+        intptr_t capacity_bytes = m_memory_end - m_memory_begin;
+        intptr_t used_bytes = m_memory_current - m_memory_begin;
+        intptr_t new_capacity_bytes = std::max(m_total_allocated_capacity, size_bytes);
+        char *memory = m_allocator->reallocate(m_memory_begin, capacity_bytes, new_capacity_bytes, used_bytes);
+        if (memory != m_memory_begin) {
+          m_stats.resize_copy_bytes += used_bytes;
+        }
+        m_memory_handles.back() = std::make_pair(memory, new_capacity_bytes);
+        m_memory_begin = memory;
+        m_memory_current = memory + size_bytes;
+        m_memory_end = memory + new_capacity_bytes;
+        m_total_allocated_capacity += new_capacity_bytes - capacity_bytes;
+        m_stats.chunk_bytes += new_capacity_bytes - capacity_bytes;
+        inout_begin = memory;
       } else {
         // If it doesn't fit, need to copy to newly malloc'd memory
         char *old_current = inout_begin, *old_end = *inout_end;
@@ -101,6 +125,7 @@ namespace nd {
         // NOTE: We're assuming malloc produces memory which has good enough alignment for anything
         append_memory(std::max(m_total_allocated_capacity, size_bytes));
         memcpy(m_memory_begin, inout_begin, *inout_end - inout_begin);
+        m_stats.resize_copy_bytes += old_end - old_current;
         end = m_memory_begin + size_bytes;
         m_memory_current = end;
         inout_begin = m_memory_begin;
@@ -129,7 +154,7 @@ namespace nd {
         // If there are more than one allocated memory chunks,
         // throw them all away except the last
         for (size_t i = 0, i_end = m_memory_handles.size() - 1; i != i_end; ++i) {
-          free(m_memory_handles[i]);
+          m_allocator->deallocate(m_memory_handles[i].first, m_memory_handles[i].second);
         }
         m_memory_handles.front() = m_memory_handles.back();
         m_memory_handles.resize(1);
@@ -148,6 +173,7 @@ namespace nd {
       } else {
         o << indent << " finalized: " << m_total_allocated_capacity << "\n";
       }
+      m_stats.debug_print(o, indent, *m_allocator);
       o << indent << "------" << std::endl;
     }
   };
@@ -0,0 +1,90 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include <dynd/memblock/base_memory_block.hpp>
+#include <dynd/types/string_type.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * The storage of a one-dimensional array of strings, together with one arena
+   * buffer for all the values that are too long to fit inside a string. Filling
+   * and destroying the array then costs two allocations however many strings
+   * there are, instead of one for every long value.
+   *
+   * The arena is sized up front with ``arena_size``. Values that do not fit in
+   * what is left of it, and values assigned to the strings after they are
+   * built, get their own allocations as usual.
+   */
+  class string_arena_memory_block : public base_memory_block {
+    intptr_t m_size;
+    string *m_strings;
+    char *m_arena_begin, *m_arena_current, *m_arena_end;
+
+  public:
+    string_arena_memory_block(intptr_t size, size_t arena_size)
+        : m_size(size), m_strings(new string[size]), m_arena_begin(NULL), m_arena_current(NULL), m_arena_end(NULL) {
+      if (arena_size > 0) {
+        try {
+          m_arena_begin = new char[arena_size];
+        } catch (...) {
+          delete[] m_strings;
+          throw;
+        }
+        m_arena_current = m_arena_begin;
+        m_arena_end = m_arena_begin + arena_size;
+      }
+    }
+
+    ~string_arena_memory_block() {
+      // The strings are destroyed first, they do not free their arena buffers
+      delete[] m_strings;
+      delete[] m_arena_begin;
+    }
+
+    /**
+     * The number of arena bytes that a value of ``size`` bytes takes, rounded
+     * up to keep the next value aligned.
+     */
+    static size_t arena_size(size_t size) {
+      return (string::arena_size(size) + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    }
+
+    intptr_t get_size() const { return m_size; }
+
+    string *get_strings() const { return m_strings; }
+
+    /**
+     * Assigns the value of string ``i``, placing it in the arena if it is too
+     * long to fit inside the string and there is room left.
+     */
+    void assign(intptr_t i, const char *data, size_t size) {
+      size_t added_size = arena_size(size);
+      if (added_size == 0 || static_cast<size_t>(m_arena_end - m_arena_current) < added_size) {
+        m_strings[i].assign(data, size);
+      } else {
+        m_strings[i].arena_assign(m_arena_current, data, size);
+        m_arena_current += added_size;
+      }
+    }
+
+    void debug_print(std::ostream &o, const std::string &indent) {
+      o << indent << "------ memory_block at " << static_cast<const void *>(this) << "\n";
+      o << indent << " reference count: " << static_cast<long>(m_use_count) << "\n";
+      o << indent << " strings: " << m_size << "\n";
+      o << indent << " arena used: " << (m_arena_current - m_arena_begin) << " of " << (m_arena_end - m_arena_begin)
+        << "\n";
+      o << indent << "------" << std::endl;
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
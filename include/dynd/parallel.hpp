@@ -0,0 +1,50 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <functional>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * Returns the number of threads that ``parallel_for`` uses when it is asked
+ * for zero threads, which is the hardware concurrency of the machine.
+ */
+DYND_API size_t hardware_concurrency();
+
+/**
+ * Returns true if the calling thread is a worker of the thread pool, i.e.
+ * it is inside a ``parallel_for``. Nested parallel loops run serially.
+ */
+DYND_API bool in_parallel_region();
+
+/**
+ * Splits the range [0, count) into chunks of at least ``grain_size``
+ * iterations and calls ``func(begin, end, worker)`` for each of them on up to
+ * ``nthreads`` threads, where ``worker`` is in [0, nthreads) and identifies
+ * the thread that runs the chunk. A given worker never runs two chunks at the
+ * same time, so per-worker state may be indexed by it. The calling thread
+ * takes part as worker 0, and the call returns once all chunks are done.
+ *
+ * Workers are kept in a process-wide pool and claim chunks from a shared
+ * counter, so uneven chunks balance themselves. If the pool is already busy,
+ * or the call is nested inside another parallel loop, the chunks run serially
+ * on the calling thread as worker 0.
+ *
+ * The first exception thrown by ``func`` stops the remaining chunks from
+ * being claimed and is rethrown on the calling thread.
+ *
+ * \param count  The number of iterations.
+ * \param grain_size  The minimum number of iterations in a chunk.
+ * \param nthreads  The maximum number of threads, or zero for one per core.
+ * \param func  The function called for every chunk.
+ */
+DYND_API void parallel_for(size_t count, size_t grain_size, size_t nthreads,
+                           const std::function<void(size_t, size_t, size_t)> &func);
+
+} // namespace dynd
@@ -18,5 +18,19 @@ namespace nd {
    */
   extern DYND_API callable binary_search;
 
+  /**
+   * Finds, for every element of the one-dimensional second argument, the
+   * index at which inserting it into the sorted first argument keeps it
+   * sorted. Takes the keyword ``side``, which is ``"left"`` (the default) to
+   * return the first such index or ``"right"`` to return the last.
+   *
+   * Builtin integers and floats are searched without a comparison kernel,
+   * in the order that ``sort`` uses, so NaNs go last.
+   *
+   * \returns  The insertion indices as an ``int64`` array the size of the
+   *           second argument.
+   */
+  extern DYND_API callable searchsorted;
+
 } // namespace dynd::nd
 } // namespace dynd
@@ -70,6 +70,23 @@ inline void multistrides_to_axis_perm(intptr_t ndim, int noperands, intptr_t **o
   multistrides_to_axis_perm(ndim, noperands, const_cast<const intptr_t **>(operstrides), out_axis_perm);
 }
 
+/**
+ * This function merges adjacent dimensions which all the operands step through
+ * as if they were one, i.e. where the stride of the outer dimension is the stride
+ * of the inner one times its size, and drops dimensions of size one. The
+ * dimensions go from outermost to innermost, and the shape and the strides are
+ * rewritten in place.
+ *
+ * \param ndim  The number of values in shape and in each operstrides array.
+ * \param shape  The shape shared by the operands.
+ * \param noperands  The number of operands.
+ * \param operstrides  The strides of every operand.
+ *
+ * \returns  The number of dimensions that remain, which is at least one if
+ *            ndim is not zero.
+ */
+DYNDT_API intptr_t coalesce_dimensions(intptr_t ndim, intptr_t *shape, int noperands, intptr_t **operstrides);
+
 DYNDT_API void print_shape(std::ostream &o, intptr_t ndim, const intptr_t *shape);
 
 inline void print_shape(std::ostream &o, const std::vector<intptr_t> &shape)
@@ -38,50 +38,70 @@ void string_concat(size_t nop, StringType &d, const StringType *const *s)
   Returns the number of times needle appears in haystack.
 */
 template <class StringType>
-intptr_t string_count(const StringType &haystack, const StringType &needle)
+intptr_t string_count(const StringType &haystack, const detail::string_searcher<StringType> &needle)
 {
   detail::string_counter f;
 
-  detail::string_search(haystack, needle, f);
+  needle.search(haystack, f);
 
   return f.finish();
 }
 
+template <class StringType>
+intptr_t string_count(const StringType &haystack, const StringType &needle)
+{
+  return string_count(haystack, detail::string_searcher<StringType>(needle));
+}
+
 /*
   Returns byte index of the first occurrence of needle in haystack.
   Returns -1 if not found.
 */
 template <class StringType>
-intptr_t string_find(const StringType &haystack, const StringType &needle)
+intptr_t string_find(const StringType &haystack, const detail::string_searcher<StringType> &needle)
 {
   detail::string_finder f;
 
-  detail::string_search(haystack, needle, f);
+  needle.search(haystack, f);
 
   return f.finish();
 }
 
+template <class StringType>
+intptr_t string_find(const StringType &haystack, const StringType &needle)
+{
+  return string_find(haystack, detail::string_searcher<StringType>(needle));
+}
+
 /*
   Returns byte index of the last occurrence of needle in haystack.
   Returns -1 if not found.
 */
 template <class StringType>
-intptr_t string_rfind(const StringType &haystack, const StringType &needle)
+intptr_t string_rfind(const StringType &haystack, const detail::string_searcher<StringType> &needle)
 {
   detail::string_finder f;
 
-  detail::string_search_reverse(haystack, needle, f);
+  needle.search_reverse(haystack, f);
 
   return f.finish();
 }
 
+template <class StringType>
+intptr_t string_rfind(const StringType &haystack, const StringType &needle)
+{
+  return string_rfind(haystack, detail::string_searcher<StringType>(needle));
+}
+
 /*
   In string `src`, replace all non-overlapping appearances of
   `old_str` with `new_str`, storing the result in `dst`.
 */
 template <class StringType>
-void string_replace(StringType &dst, const StringType &src, const StringType &old_str, const StringType &new_str)
+void string_replace(StringType &dst, const StringType &src, const detail::string_searcher<StringType> &old_searcher,
+                    const StringType &new_str)
 {
+  const StringType &old_str = old_searcher.needle();
 
   if (old_str.size() == 0 || old_str.size() > src.size()) {
     /* Just copy -- there's nothing to replace */
@@ -104,24 +124,30 @@ void string_replace(StringType &dst, const StringType &src, const StringType &ol
     }
     else {
       detail::string_inplace_replacer<StringType> replacer(dst, new_str);
-      detail::string_search(src, old_str, replacer);
+      old_searcher.search(src, replacer);
     }
   }
   else {
     /* Most general case, where old_str and new_str are different
        lengths.  Count matches to determine resulting string length,
        then interleave to make the result. */
-    intptr_t count = string_count(src, old_str);
+    intptr_t count = string_count(src, old_searcher);
     size_t delta = ((intptr_t)new_str.size() - (intptr_t)old_str.size()) * count;
 
     dst.resize((intptr_t)src.size() + delta);
 
     detail::string_copy_replacer<StringType> replacer(dst, src, old_str, new_str);
-    detail::string_search(src, old_str, replacer);
+    old_searcher.search(src, replacer);
     replacer.finish();
   }
 }
 
+template <class StringType>
+void string_replace(StringType &dst, const StringType &src, const StringType &old_str, const StringType &new_str)
+{
+  string_replace(dst, src, detail::string_searcher<StringType>(old_str), new_str);
+}
+
 /*
   Returns `true` if `str` starts with `sub`.
 */
@@ -152,15 +178,21 @@ bool string_endswith(const StringType &str, const StringType &sub)
   Returns `true` if `str` contains `sub`.
 */
 template <class StringType>
-bool string_contains(const StringType &str, const StringType &sub)
+bool string_contains(const StringType &str, const detail::string_searcher<StringType> &sub)
 {
   detail::string_contains f;
 
-  detail::string_search(str, sub, f);
+  sub.search(str, f);
 
   return f.finish();
 }
 
+template <class StringType>
+bool string_contains(const StringType &str, const StringType &sub)
+{
+  return string_contains(str, detail::string_searcher<StringType>(sub));
+}
+
 namespace nd {
 
   extern DYND_API callable string_concatenation;
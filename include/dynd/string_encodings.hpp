@@ -98,6 +98,27 @@ get_next_unicode_codepoint_function(string_encoding_t encoding, assign_error_mod
 DYNDT_API append_unicode_codepoint_t
 get_append_unicode_codepoint_function(string_encoding_t encoding, assign_error_mode errmode);
 
+/**
+ * Typedef for converting a run of ASCII characters from one encoding to
+ * another in bulk, much faster than one code point at a time.
+ *
+ * It converts the characters from 'src' up to the first one that is NUL or
+ * not ASCII, stopping early if 'src_end' or 'dst_end' is reached, and updates
+ * 'src' and 'dst' in-place to be after what was converted. Callers convert
+ * the character it stopped at with the next/append functions and call it
+ * again for the rest.
+ */
+typedef void (*transcode_ascii_t)(const char *&src, const char *src_end, char *&dst, char *dst_end);
+
+DYNDT_API transcode_ascii_t get_transcode_ascii_function(string_encoding_t dst_encoding,
+                                                         string_encoding_t src_encoding);
+
+/**
+ * Returns the start of the first invalid UTF-8 sequence in the buffer, or
+ * 'end' if it is all valid. Runs of ASCII are checked 16 bytes at a time.
+ */
+DYNDT_API const char *find_invalid_utf8(const char *begin, const char *end);
+
 /**
  * Converts a string buffer provided as a range of bytes into a std::string as UTF8.
  */
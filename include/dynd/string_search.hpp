@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include <cstring>
+
+#include <dynd/config.hpp>
+
 ////////////////////////////////////////////////////////////
 // String algorithms
 
@@ -43,7 +47,7 @@ namespace detail {
     else {
       const char *s = haystack;
       while (s < haystack + n) {
-        void *candidate = memchr((void *)s, needle, n);
+        void *candidate = memchr((void *)s, needle, haystack + n - s);
         if (candidate == NULL) {
           return;
         }
@@ -59,7 +63,7 @@ namespace detail {
   template <class match_handler>
   void string_search_1char_reverse(const char *haystack, size_t n, char needle, match_handler &handle_match)
   {
-    for (size_t i = n - 1; i <= 0; --i) {
+    for (size_t i = n; i-- > 0;) {
       if (haystack[i] == needle) {
         if (handle_match(i)) {
           return;
@@ -69,7 +73,7 @@ namespace detail {
   }
 
   template <class StringType, class match_handler>
-  void string_search(const StringType &haystack, const StringType &needle, match_handler &handle_match)
+  void string_search_scalar(const StringType &haystack, const StringType &needle, match_handler &handle_match)
   {
     /*
       This is a mostly direct copy of the algorithm by Fredrik Lundh in
@@ -147,6 +151,7 @@ namespace detail {
             return;
           }
           i = i + mlast;
+          continue;
         }
         /* miss: check if next character is part of pattern */
         if (i < w && !bloom.has_char(ss[i + 1])) {
@@ -168,7 +173,8 @@ namespace detail {
   }
 
   template <class StringType, class match_handler>
-  void string_search_reverse(const StringType &haystack, const StringType &needle, match_handler &handle_match)
+  void string_search_reverse_scalar(const StringType &haystack, const StringType &needle,
+                                    match_handler &handle_match)
   {
     const char *s = haystack.begin();
     const char *p = needle.begin();
@@ -243,6 +249,105 @@ namespace detail {
     return;
   }
 
+  /**
+   * A function that returns the position of the first (or last) occurrence
+   * of the needle [p, p + m) in the haystack [s, s + n), or n if there is
+   * none. It requires 1 <= m <= n.
+   */
+  typedef size_t (*substring_find_t)(const char *s, size_t n, const char *p, size_t m);
+
+  /**
+   * Returns the vectorized substring search for the instruction set that
+   * ``get_simd_isa`` allows, or NULL if there is none. It compares the first
+   * and last characters of the needle against 32 positions of the haystack
+   * at once, and only compares the positions where both match in full.
+   * ``reverse`` selects the search for the last occurrence.
+   */
+  DYND_API substring_find_t get_simd_substring_find(bool reverse);
+
+  /**
+   * Haystacks shorter than this are searched with the scalar algorithms.
+   */
+  const size_t simd_search_min_size = 32;
+
+  /**
+   * A needle prepared for searching, so that the search is only chosen once
+   * when the same needle is searched for several times, as ``string_replace``
+   * does to count and then replace its occurrences.
+   */
+  template <class StringType>
+  class string_searcher {
+    const StringType &m_needle;
+    substring_find_t m_find;
+    substring_find_t m_rfind;
+
+  public:
+    explicit string_searcher(const StringType &needle)
+        : m_needle(needle), m_find(get_simd_substring_find(false)), m_rfind(get_simd_substring_find(true))
+    {
+    }
+
+    const StringType &needle() const { return m_needle; }
+
+    /**
+     * Calls ``handle_match`` with the position of every non-overlapping
+     * occurrence of the needle in order, until it returns true.
+     */
+    template <class match_handler>
+    void search(const StringType &haystack, match_handler &handle_match) const
+    {
+      const char *s = haystack.begin(), *p = m_needle.begin();
+      size_t n = haystack.size(), m = m_needle.size();
+      // Single characters are left to memchr
+      if (m_find == NULL || m <= 1 || n < simd_search_min_size) {
+        string_search_scalar(haystack, m_needle, handle_match);
+        return;
+      }
+
+      for (size_t i = 0; n - i >= m;) {
+        size_t k = m_find(s + i, n - i, p, m);
+        if (k == n - i || handle_match(i + k)) {
+          return;
+        }
+        i += k + m;
+      }
+    }
+
+    /**
+     * Like ``search``, but from the end of the haystack to its start.
+     */
+    template <class match_handler>
+    void search_reverse(const StringType &haystack, match_handler &handle_match) const
+    {
+      const char *s = haystack.begin(), *p = m_needle.begin();
+      size_t n = haystack.size(), m = m_needle.size();
+      if (m_rfind == NULL || m == 0 || n < simd_search_min_size) {
+        string_search_reverse_scalar(haystack, m_needle, handle_match);
+        return;
+      }
+
+      for (size_t end = n; end >= m;) {
+        size_t k = m_rfind(s, end, p, m);
+        if (k == end || handle_match(k)) {
+          return;
+        }
+        end = k;
+      }
+    }
+  };
+
+  template <class StringType, class match_handler>
+  void string_search(const StringType &haystack, const StringType &needle, match_handler &handle_match)
+  {
+    string_searcher<StringType>(needle).search(haystack, handle_match);
+  }
+
+  template <class StringType, class match_handler>
+  void string_search_reverse(const StringType &haystack, const StringType &needle, match_handler &handle_match)
+  {
+    string_searcher<StringType>(needle).search_reverse(haystack, handle_match);
+  }
+
   struct string_finder {
     intptr_t m_result;
 
@@ -366,4 +471,4 @@ namespace detail {
   };
 
 } // namespace detail
-} // namespace nd
+} // namespace dynd
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 
@@ -145,7 +146,11 @@ namespace ndt {
     type(const char *rep_begin, const char *rep_end);
 
     bool operator==(const type &rhs) const {
-      return m_ptr == rhs.m_ptr || (!is_builtin() && !rhs.is_builtin() && *m_ptr == *rhs.m_ptr);
+      // Two different interned instances are never equal. This relies on the
+      // intern table hashing types only on what the deep ``operator==``
+      // compares, so an equal type always finds the existing instance
+      return m_ptr == rhs.m_ptr || (!is_builtin() && !rhs.is_builtin() &&
+                                    !(m_ptr->is_interned() && rhs.m_ptr->is_interned()) && *m_ptr == *rhs.m_ptr);
     }
 
     bool operator!=(const type &rhs) const { return !(operator==(rhs)); }
@@ -724,66 +729,93 @@ namespace ndt {
   }
 
   /**
-   * Allocates and constructs a type with a use count of 1.
+   * Returns the instance of the type that all the interned types equal to
+   * ``tp`` share, adding ``tp`` to the intern table if there is none yet.
+   * Builtin types are returned as they are. Interned types are never freed.
+   */
+  DYNDT_API type intern(const type &tp);
+
+  /**
+   * Turns interning of the types that ``make_type`` constructs on or off. It is
+   * off by default. With it on, structurally identical types are the same
+   * instance, so comparing them is a pointer comparison.
+   */
+  DYNDT_API void set_type_interning(bool enabled);
+
+  DYNDT_API bool get_type_interning();
+
+  namespace detail {
+
+    extern DYNDT_API std::atomic<bool> type_interning;
+
+    inline type make_interned(type &&tp) {
+      return type_interning.load(std::memory_order_relaxed) ? intern(tp) : std::move(tp);
+    }
+
+  } // namespace dynd::ndt::detail
+
+  /**
+   * Allocates and constructs a type with a use count of 1, or returns the
+   * interned instance equal to it if type interning is on.
    */
   template <typename T, typename... ArgTypes>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(ArgTypes &&... args) {
-    return type(new T(id_of<T>::value, std::forward<ArgTypes>(args)...), false);
+    return detail::make_interned(type(new T(id_of<T>::value, std::forward<ArgTypes>(args)...), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(std::initializer_list<type> field_tp) {
-    return type(new T(id_of<T>::value, field_tp), false);
+    return detail::make_interned(type(new T(id_of<T>::value, field_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(std::initializer_list<type> field_tp,
                                                                          bool variadic) {
-    return type(new T(id_of<T>::value, field_tp, variadic), false);
+    return detail::make_interned(type(new T(id_of<T>::value, field_tp, variadic), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(std::initializer_list<std::string> field_names,
                                                                          std::initializer_list<type> field_tp) {
-    return type(new T(id_of<T>::value, field_names, field_tp), false);
+    return detail::make_interned(type(new T(id_of<T>::value, field_names, field_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(std::initializer_list<std::pair<type, std::string>> fields) {
-    return type(new T(id_of<T>::value, fields), false);
+    return detail::make_interned(type(new T(id_of<T>::value, fields), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(std::initializer_list<std::pair<type, std::string>> fields, bool variadic) {
-    return type(new T(id_of<T>::value, fields, variadic), false);
+    return detail::make_interned(type(new T(id_of<T>::value, fields, variadic), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(std::initializer_list<std::string> field_names, std::initializer_list<type> field_tp, bool variadic) {
-    return type(new T(id_of<T>::value, field_names, field_tp, variadic), false);
+    return detail::make_interned(type(new T(id_of<T>::value, field_names, field_tp, variadic), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type> make_type(const type &ret_tp,
                                                                          std::initializer_list<type> arg_tp) {
-    return type(new T(id_of<T>::value, ret_tp, arg_tp), false);
+    return detail::make_interned(type(new T(id_of<T>::value, ret_tp, arg_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(const type &ret_tp, std::initializer_list<type> arg_tp,
             std::initializer_list<std::pair<type, std::string>> kwd_tp) {
-    return type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false);
+    return detail::make_interned(type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false));
   }
 
   template <typename T>
   std::enable_if_t<std::is_base_of<base_type, T>::value, type>
   make_type(const type &ret_tp, std::initializer_list<type> arg_tp,
             const std::vector<std::pair<type, std::string>> &kwd_tp) {
-    return type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false);
+    return detail::make_interned(type(new T(id_of<T>::value, ret_tp, arg_tp, kwd_tp), false));
   }
 
   /*
@@ -86,6 +86,8 @@ namespace ndt {
   class DYNDT_API base_type {
     /** Embedded reference counting */
     mutable std::atomic_long m_use_count;
+    /** Whether this is the instance in the intern table */
+    mutable std::atomic_bool m_interned;
 
   protected:
     type_id_t m_id;          // The type id
@@ -100,7 +102,7 @@ namespace ndt {
     /** Starts off the extended type instance with a use count of 1. */
     base_type(type_id_t id, size_t data_size, size_t data_alignment, uint32_t flags, size_t arrmeta_size, size_t ndim,
               size_t strided_ndim)
-        : m_use_count(1), m_id(id), m_metadata_size(arrmeta_size), m_data_size(data_size),
+        : m_use_count(1), m_interned(false), m_id(id), m_metadata_size(arrmeta_size), m_data_size(data_size),
           m_data_alignment(data_alignment), flags(flags), m_ndim(ndim), m_fixed_ndim(strided_ndim) {}
 
     virtual ~base_type();
@@ -134,6 +136,12 @@ namespace ndt {
 
     uint32_t get_flags() const { return flags; }
 
+    /**
+     * Whether this is the instance in the intern table, which no other
+     * interned instance is equal to.
+     */
+    bool is_interned() const { return m_interned.load(std::memory_order_relaxed); }
+
     virtual size_t get_default_data_size() const;
 
     /**
@@ -484,6 +492,7 @@ namespace ndt {
     friend long intrusive_ptr_use_count(const base_type *ptr);
 
     friend type make_dynamic_type(type_id_t tp_id);
+    friend type intern(const type &tp);
   };
 
   /**
@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <dynd/array.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -31,6 +35,17 @@ namespace ndt {
     nd::array m_category_index_to_value;
     // mapping from values to category indices
     nd::array m_value_to_category_index;
+    // mapping from the bytes of each category to its value, empty if the
+    // category type has no canonical bytes to hash
+    std::unordered_map<std::string, uint32_t> m_value_from_bytes;
+    // for at most 16 integer categories of up to 32 bits, the categories in
+    // order of value, widened to int32 and padded to a multiple of four by
+    // repeating the first one
+    std::vector<int32_t> m_small_int_categories;
+
+    void make_index();
+
+    bool get_category_bytes(const char *category_data, std::string &out) const;
 
   public:
     categorical_type(type_id_t new_id, const nd::array &categories, bool presorted = false);
@@ -59,6 +74,22 @@ namespace ndt {
     uint32_t get_value_from_category(const char *category_arrmeta, const char *category_data) const;
     uint32_t get_value_from_category(const nd::array &category) const;
 
+    /**
+     * Encodes ``count`` values of the category type, ``src_stride`` bytes
+     * apart, as values of the storage type, ``dst_stride`` bytes apart. The
+     * categories are looked up in a hash index built with the type, and sets
+     * of up to 16 small integer categories are compared with SIMD instead.
+     * Throws if a value is not one of the categories.
+     */
+    void encode_categories(char *dst, intptr_t dst_stride, const char *src_arrmeta, const char *src,
+                           intptr_t src_stride, size_t count) const;
+
+    /**
+     * Encodes a one-dimensional array of category values, returning an array
+     * of the storage type.
+     */
+    nd::array encode_categories(const nd::array &values) const;
+
     const char *get_category_data_from_value(uint32_t value) const {
       if (value >= get_category_count()) {
         throw std::runtime_error("category value is out of bounds");
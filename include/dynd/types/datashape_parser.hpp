@@ -34,6 +34,36 @@ inline ndt::type type_from_datashape(const char (&datashape)[N]) {
   return type_from_datashape(datashape, datashape + N - 1);
 }
 
+/**
+ * Statistics of the cache of parsed types that ``type_from_datashape`` keeps,
+ * keyed on the datashape text.
+ */
+struct datashape_cache_stats {
+  /** The number of datashapes that were found in the cache */
+  size_t hits = 0;
+  /** The number of datashapes that had to be parsed */
+  size_t misses = 0;
+  /** The number of types evicted to stay within the capacity */
+  size_t evictions = 0;
+  /** The number of types in the cache */
+  size_t size = 0;
+  /** The maximum number of types in the cache */
+  size_t capacity = 0;
+};
+
+DYNDT_API datashape_cache_stats get_datashape_cache_stats();
+
+/**
+ * Changes the maximum number of types in the datashape cache, evicting the
+ * least recently used ones if there are more. Zero disables the cache.
+ */
+DYNDT_API void set_datashape_cache_capacity(size_t capacity);
+
+/**
+ * Empties the datashape cache and resets its statistics.
+ */
+DYNDT_API void clear_datashape_cache();
+
 namespace datashape {
 
   /**
@@ -20,6 +20,12 @@ namespace dynd {
 template <size_t NulPadding>
 class sso_bytestring {
 protected:
+  /**
+   * The bit of the stored capacity that marks a data buffer as part of an arena, which frees all of its buffers at
+   * once, so the bytestring never frees it itself.
+   */
+  static const size_t arena_capacity_flag = static_cast<size_t>(1) << (8 * sizeof(size_t) - 1);
+
   int64_t m_pointer;
   int64_t m_size;
 
@@ -48,7 +54,15 @@ protected:
   char *heap_data() { return heap_buffer() + sizeof(size_t); }
   const char *heap_data() const { return heap_buffer() + sizeof(size_t); }
   /** When SSO is not used, the capacity is stored at the start of the data buffer */
-  size_t heap_capacity() const { return *reinterpret_cast<const size_t *>(heap_buffer()); }
+  size_t heap_capacity() const { return *reinterpret_cast<const size_t *>(heap_buffer()) & ~arena_capacity_flag; }
+  /** When SSO is not used, whether the data buffer belongs to an arena instead of this object */
+  bool heap_is_arena() const { return (*reinterpret_cast<const size_t *>(heap_buffer()) & arena_capacity_flag) != 0; }
+  /** When SSO is not used, frees the data buffer unless it belongs to an arena */
+  void heap_free() {
+    if (!heap_is_arena()) {
+      delete[] heap_buffer();
+    }
+  }
   /**
    * When the object has no memory allocated straight heap assignment overwriting existing data.
    * NOTE: If it throws (memory allocation failure), it hasn't written into `this`.
@@ -77,6 +91,11 @@ public:
   }
 
   sso_bytestring(sso_bytestring &&rhs) {
+    if (!rhs.is_sso() && rhs.heap_is_arena()) {
+      // The arena may not outlive this object, so the value is copied
+      heap_assign(rhs.data(), rhs.size());
+      return;
+    }
     m_pointer = rhs.m_pointer;
     m_size = rhs.m_size;
     rhs.m_pointer = 0;
@@ -93,7 +112,7 @@ public:
 
   ~sso_bytestring() {
     if (!is_sso()) {
-      delete[] heap_buffer();
+      heap_free();
     }
   }
 
@@ -123,19 +142,57 @@ public:
       m_size = ~static_cast<int64_t>(size);
     } else {
       char *buffer = heap_buffer();
+      bool arena = heap_is_arena();
       heap_assign(bytestr, size);
-      delete[] buffer;
+      if (!arena) {
+        delete[] buffer;
+      }
     }
   }
 
+  /**
+   * The number of bytes that `arena_assign` needs from an arena for a value of `size` bytes, which is 0 when the
+   * value fits in the object itself.
+   */
+  static size_t arena_size(size_t size) { return size <= 15u - NulPadding ? 0 : sizeof(size_t) + size + NulPadding; }
+
+  /**
+   * Assigns the provided byte string by value, placing it in `buffer` if it does not fit in the object itself. The
+   * buffer must hold `arena_size(size)` bytes, be aligned for a size_t and outlive the bytestring, which never frees
+   * it. Assigning a longer value later moves the bytestring to its own allocation as usual.
+   */
+  void arena_assign(char *buffer, const char *bytestr, size_t size) {
+    if (!is_sso()) {
+      heap_free();
+    }
+    if (size <= sso_capacity()) {
+      sso_assign(bytestr, size);
+    } else {
+      *reinterpret_cast<size_t *>(buffer) = size | arena_capacity_flag;
+      DYND_MEMCPY(buffer + sizeof(size_t), bytestr, size);
+      if (NulPadding) {
+        buffer[sizeof(size_t) + size] = 0;
+      }
+      m_pointer = reinterpret_cast<intptr_t>(buffer);
+      m_size = ~static_cast<int64_t>(size);
+    }
+  }
+
+  /** Whether the value is stored in an arena buffer given to `arena_assign` */
+  bool is_arena() const { return !is_sso() && heap_is_arena(); }
+
   sso_bytestring &operator=(const sso_bytestring &rhs) {
     assign(rhs.data(), rhs.size());
     return *this;
   }
 
   sso_bytestring &operator=(sso_bytestring &&rhs) {
+    if (!rhs.is_sso() && rhs.heap_is_arena()) {
+      assign(rhs.data(), rhs.size());
+      return *this;
+    }
     if (!is_sso()) {
-      delete[] heap_buffer();
+      heap_free();
     }
     m_pointer = rhs.m_pointer;
     m_size = rhs.m_size;
@@ -152,7 +209,7 @@ public:
 
   void clear() {
     if (!is_sso()) {
-      delete[] heap_buffer();
+      heap_free();
     }
     m_pointer = 0;
     m_size = 0;
@@ -166,7 +223,7 @@ public:
       *reinterpret_cast<size_t *>(new_data) = new_capacity;
       DYND_MEMCPY(new_data + sizeof(size_t), data(), current_size + NulPadding);
       if (!is_sso()) {
-        delete[] heap_buffer();
+        heap_free();
       }
       m_size = ~static_cast<int64_t>(current_size);
       m_pointer = reinterpret_cast<intptr_t>(new_data);
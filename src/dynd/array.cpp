@@ -15,6 +15,7 @@
 #include <dynd/kernels/field_access_kernel.hpp>
 #include <dynd/math.hpp>
 #include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/memblock/string_arena_memory_block.hpp>
 #include <dynd/option.hpp>
 #include <dynd/types/base_memory_type.hpp>
 #include <dynd/types/bytes_type.hpp>
@@ -24,6 +25,7 @@
 #include <dynd/types/datashape_formatter.hpp>
 #include <dynd/types/datashape_formatter.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
+#include <dynd/types/fixed_dim_kind_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/string_type.hpp>
@@ -449,7 +451,7 @@ static void permute_type_dims(const ndt::type &tp, intptr_t arrmeta_offset, void
       // No more perm dimensions left, leave type as is
       out_transformed_tp = tp;
     } else {
-      if (tp.get_base_id() == dim_kind_id) {
+      if (tp.get_ndim() > 0) {
         ++pdd->i;
       }
       tp.extended()->transform_child_types(&permute_type_dims, arrmeta_offset, extra, out_transformed_tp,
@@ -886,37 +888,120 @@ nd::array nd::reshape(const nd::array &a, const nd::array &shape) {
                                       NULL);
 }
 
-nd::array nd::memmap(const std::string &DYND_UNUSED(filename), intptr_t DYND_UNUSED(begin), intptr_t DYND_UNUSED(end),
-                     uint32_t DYND_UNUSED(access)) {
-  throw std::runtime_error("nd::memmap is not yet implemented");
+nd::array nd::memmap(const std::string &filename, intptr_t begin, intptr_t end, uint32_t access, uint32_t flags) {
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, access, &mm_ptr, &mm_size, begin, end, flags);
 
-  /*
-    // ToDo: This was based on the variable-sized bytes type, which changed.
+  array result = make_array(ndt::make_fixed_dim(mm_size, ndt::make_type<uint8_t>()), mm_ptr, mm, access);
+  result.get_type().extended()->arrmeta_default_construct(result.get()->metadata(), false);
+  return result;
+}
+
+nd::array nd::memmap(const std::string &filename, const ndt::type &tp, intptr_t offset, uint32_t access,
+                     uint32_t flags) {
+  if ((tp.get_flags() & (type_flag_blockref | type_flag_destructor)) != 0) {
+    stringstream ss;
+    ss << "cannot memory map dynd type " << tp << ", it does not have a fixed layout";
+    throw type_error(ss.str());
+  }
+  if (offset < 0 || offset % tp.get_data_alignment() != 0) {
+    stringstream ss;
+    ss << "cannot memory map dynd type " << tp << " at offset " << offset << ", which is not aligned";
+    throw invalid_argument(ss.str());
+  }
 
-    if (access == 0) {
-      access = nd::default_access_flags;
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  memory_block mm;
+  ndt::type result_tp = tp;
+  if (tp.get_id() == fixed_dim_kind_id) {
+    // The dimension takes all the elements from the offset to the end of the file
+    const ndt::type &element_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+    if (element_tp.is_symbolic()) {
+      stringstream ss;
+      ss << "cannot memory map symbolic dynd type " << tp;
+      throw type_error(ss.str());
+    }
+    mm = make_memory_block<memmap_memory_block>(filename, access, &mm_ptr, &mm_size, offset,
+                                                std::numeric_limits<intptr_t>::max(), flags);
+    result_tp = ndt::make_fixed_dim(mm_size / element_tp.get_default_data_size(), element_tp);
+  } else {
+    if (tp.is_symbolic()) {
+      stringstream ss;
+      ss << "cannot memory map symbolic dynd type " << tp;
+      throw type_error(ss.str());
+    }
+    intptr_t data_size = tp.get_default_data_size();
+    mm = make_memory_block<memmap_memory_block>(filename, access, &mm_ptr, &mm_size, offset, offset + data_size,
+                                                flags);
+    if (mm_size < data_size) {
+      stringstream ss;
+      ss << "file \"" << filename << "\" is too small to memory map dynd type " << tp << " at offset " << offset;
+      throw invalid_argument(ss.str());
     }
+  }
 
-    char *mm_ptr = NULL;
-    intptr_t mm_size = 0;
-    // Create a memory mapped memblock of the file
-    intrusive_ptr<memory_block_data> mm = make_memmap_memory_block(filename, access, &mm_ptr, &mm_size, begin, end);
-    // Create a bytes array referring to the data.
-    ndt::type dt = ndt::make_type<ndt::bytes_type>(1);
-    char *data_ptr = 0;
-    nd::array result(make_array(dt.extended()->get_arrmeta_size(), dt.get_data_size(),
-                                             dt.get_data_alignment(), &data_ptr));
-    // Set the bytes extents
-    reinterpret_cast<bytes *>(data_ptr)->assign(mm_ptr, mm_size);
-    // Set the array arrmeta
-    array_preamble *ndo = result.get();
-    ndo->set_type(dt);
-    ndo->flags = access;
-    // Set the bytes arrmeta, telling the system
-    // about the memmapped memblock
-    ndo_meta->blockref = mm.release();
-    return result;
-  */
+  array result = make_array(result_tp, mm_ptr, mm, access);
+  if (!result_tp.is_builtin()) {
+    result_tp.extended()->arrmeta_default_construct(result.get()->metadata(), false);
+  }
+  return result;
+}
+
+void nd::memmap_flush(const array &a, bool async) {
+  memory_block mm = a.get_data_memblock();
+  memmap_memory_block *mmb = dynamic_cast<memmap_memory_block *>(mm.get());
+  if (mmb == NULL) {
+    throw invalid_argument("memmap_flush: the array does not view a memory mapped file");
+  }
+
+  // The bytes that the array spans, relative to its data pointer, from the
+  // element size and the extent of every dimension in either direction
+  intptr_t begin = 0, end = a.get_dtype().get_data_size();
+  std::vector<intptr_t> shape = a.get_shape(), strides = a.get_strides();
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] == 0) {
+      return;
+    }
+    if (strides[i] < 0) {
+      begin += (shape[i] - 1) * strides[i];
+    } else {
+      end += (shape[i] - 1) * strides[i];
+    }
+  }
+
+  // The memory block rounds the range out to whole pages
+  intptr_t offset = mmb->get_offset(a.cdata());
+  mmb->flush(offset + begin, offset + end, async);
+}
+
+nd::array nd::make_string_array(intptr_t size, const char *const *begins, const char *const *ends) {
+  size_t arena_size = 0;
+  for (intptr_t i = 0; i < size; ++i) {
+    arena_size += string_arena_memory_block::arena_size(ends[i] - begins[i]);
+  }
+
+  memory_block arena = make_memory_block<string_arena_memory_block>(size, arena_size);
+  string_arena_memory_block *sa = static_cast<string_arena_memory_block *>(arena.get());
+  for (intptr_t i = 0; i < size; ++i) {
+    sa->assign(i, begins[i], ends[i] - begins[i]);
+  }
+
+  array result = make_array(ndt::make_fixed_dim(size, ndt::make_type<ndt::string_type>()),
+                            reinterpret_cast<char *>(sa->get_strings()), arena, default_access_flags);
+  result.get_type().extended()->arrmeta_default_construct(result.get()->metadata(), false);
+  return result;
+}
+
+nd::array nd::make_string_array(const std::vector<std::string> &values) {
+  vector<const char *> begins(values.size()), ends(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    begins[i] = values[i].data();
+    ends[i] = values[i].data() + values[i].size();
+  }
+
+  return make_string_array(values.size(), begins.data(), ends.data());
 }
 
 nd::array nd::combine_into_tuple(size_t field_count, const array *field_values) {
@@ -11,17 +11,38 @@ using namespace dynd;
 
 nd::base_callable::~base_callable() {}
 
+std::shared_ptr<nd::call_cache::entry>
+nd::base_callable::resolve_cached(const ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp, size_t nkwd,
+                                  const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
+  assign_error_mode errmode = eval::default_eval_context.errmode;
+  if (nkwd == 0) {
+    std::shared_ptr<call_cache::entry> e = m_cache.find(dst_tp, nsrc, src_tp, errmode);
+    if (e != nullptr) {
+      return e;
+    }
+  }
+
+  std::shared_ptr<call_cache::entry> e = std::make_shared<call_cache::entry>(dst_tp, nsrc, src_tp, errmode);
+  e->res_tp = resolve(nullptr, nullptr, e->cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+
+  if (nkwd == 0) {
+    m_cache.insert(e);
+  }
+
+  return e;
+}
+
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, char *const *src_data, size_t nkwd, const array *kwds,
                                   const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<call_cache::entry> e = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  dst_tp = e->res_tp;
 
   // Allocate the destination array
   array dst = alloc(&dst_tp);
 
   // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(e->cg.get());
   kb(kernel_request_single, nullptr, dst->metadata(), nsrc, src_arrmeta);
 
   kernel_single_t fn = kb.get()->get_function<kernel_single_t>();
@@ -33,14 +54,14 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::type *src_tp,
                                   const char *const *src_arrmeta, const array *src_data, size_t nkwd, const array *kwds,
                                   const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  dst_tp = resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<call_cache::entry> e = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  dst_tp = e->res_tp;
 
   // Allocate the destination array
   array dst = empty(dst_tp);
 
   // Generate and evaluate the kernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(e->cg.get());
   kb(kernel_request_call, nullptr, dst->metadata(), nsrc, src_arrmeta);
 
   kernel_call_t fn = kb.get()->get_function<kernel_call_t>();
@@ -52,11 +73,10 @@ nd::array nd::base_callable::call(ndt::type &dst_tp, size_t nsrc, const ndt::typ
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data,
                              size_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<call_cache::entry> e = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
   // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(e->cg.get());
   kb(kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
 
   kernel_single_t fn = kb.get()->get_function<kernel_single_t>();
@@ -66,11 +86,10 @@ void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, c
 void nd::base_callable::call(const ndt::type &dst_tp, const char *dst_arrmeta, array *dst, size_t nsrc,
                              const ndt::type *src_tp, const char *const *src_arrmeta, const array *src, size_t nkwd,
                              const array *kwds, const std::map<std::string, ndt::type> &tp_vars) {
-  call_graph cg;
-  resolve(nullptr, nullptr, cg, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+  std::shared_ptr<call_cache::entry> e = resolve_cached(dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
   // Generate and evaluate the ckernel
-  kernel_builder kb(cg.get());
+  kernel_builder kb(e->cg.get());
   kb(kernel_request_call, nullptr, dst_arrmeta, nsrc, src_arrmeta);
 
   kernel_call_t fn = kb.get()->get_function<kernel_call_t>();
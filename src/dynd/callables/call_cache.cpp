@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/callables/call_cache.hpp>
+
+using namespace std;
+using namespace dynd;
+
+std::atomic_long nd::call_cache::s_generation(0);
+
+nd::call_cache::call_cache(size_t capacity) : m_capacity(capacity), m_generation(s_generation) {}
+
+void nd::call_cache::flush_if_stale() {
+  long generation = s_generation;
+  if (m_generation != generation) {
+    m_entries.clear();
+    m_generation = generation;
+  }
+}
+
+std::shared_ptr<nd::call_cache::entry> nd::call_cache::find(const ndt::type &res_tp, size_t narg,
+                                                            const ndt::type *arg_tp, assign_error_mode errmode) {
+  lock_guard<mutex> lock(m_mutex);
+  flush_if_stale();
+
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+    if ((*it)->matches(res_tp, narg, arg_tp, errmode)) {
+      if (it != m_entries.begin()) {
+        m_entries.splice(m_entries.begin(), m_entries, it);
+      }
+      return m_entries.front();
+    }
+  }
+
+  return nullptr;
+}
+
+void nd::call_cache::insert(const std::shared_ptr<entry> &e) {
+  lock_guard<mutex> lock(m_mutex);
+  flush_if_stale();
+
+  if (m_capacity == 0) {
+    return;
+  }
+
+  // Another thread may have resolved the same types in the meantime
+  for (const std::shared_ptr<entry> &other : m_entries) {
+    if (other->errmode == e->errmode && other->key == e->key) {
+      return;
+    }
+  }
+
+  m_entries.push_front(e);
+  while (m_entries.size() > m_capacity) {
+    m_entries.pop_back();
+  }
+}
+
+void nd::call_cache::clear() {
+  lock_guard<mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+size_t nd::call_cache::size() {
+  lock_guard<mutex> lock(m_mutex);
+  flush_if_stale();
+
+  return m_entries.size();
+}
+
+void nd::call_cache::set_capacity(size_t capacity) {
+  lock_guard<mutex> lock(m_mutex);
+  m_capacity = capacity;
+  while (m_entries.size() > m_capacity) {
+    m_entries.pop_back();
+  }
+}
+
+void nd::call_cache::invalidate_all() { ++s_generation; }
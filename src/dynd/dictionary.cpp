@@ -0,0 +1,205 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <dynd/dictionary.hpp>
+#include <dynd/kernels/unique_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const uint32_t empty_slot = numeric_limits<uint32_t>::max();
+
+const ndt::type &get_element_type(const nd::array &a, const char *name) {
+  const ndt::type &tp = a.get_type();
+  if (tp.get_id() != fixed_dim_id) {
+    stringstream ss;
+    ss << name << ": expected a one-dimensional array, not one of type " << tp;
+    throw type_error(ss.str());
+  }
+
+  return tp.extended<ndt::fixed_dim_type>()->get_element_type();
+}
+
+void check_encoded(const nd::array &encoded, nd::array &codes, nd::array &dictionary, const char *name) {
+  const ndt::type &tp = encoded.get_type();
+  if (tp.get_id() != struct_id || tp.extended<ndt::struct_type>()->get_field_index("codes") < 0 ||
+      tp.extended<ndt::struct_type>()->get_field_index("dictionary") < 0) {
+    stringstream ss;
+    ss << name << ": expected a dictionary-encoded array, not one of type " << tp;
+    throw type_error(ss.str());
+  }
+
+  codes = encoded.p("codes");
+  dictionary = encoded.p("dictionary");
+  if (get_element_type(codes, name).get_id() != uint32_id) {
+    stringstream ss;
+    ss << name << ": the codes of a dictionary-encoded array must be uint32, not " << codes.get_type();
+    throw type_error(ss.str());
+  }
+  get_element_type(dictionary, name);
+}
+
+/**
+ * Returns the array whose element i is ``values[codes[i]]``.
+ */
+nd::array gather(const nd::array &values, const nd::array &codes, const char *name) {
+  const ndt::type &element_tp = get_element_type(values, name);
+  bool fixed_layout = element_tp.get_ndim() == 0 &&
+                      (element_tp.get_flags() & (type_flag_blockref | type_flag_destructor)) == 0;
+  if (!fixed_layout && element_tp.get_id() != string_id) {
+    stringstream ss;
+    ss << name << ": cannot expand values of type " << element_tp;
+    throw type_error(ss.str());
+  }
+
+  const fixed_dim_type_arrmeta *values_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(values.get()->metadata());
+  const fixed_dim_type_arrmeta *codes_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(codes.get()->metadata());
+  uint32_t count = static_cast<uint32_t>(values_md->dim_size);
+  size_t element_size = element_tp.get_data_size();
+
+  const char *codes_data = codes.cdata();
+  auto get_value = [&](intptr_t i) {
+    uint32_t code = *reinterpret_cast<const uint32_t *>(codes_data + i * codes_md->stride);
+    if (code >= count) {
+      stringstream ss;
+      ss << name << ": code " << code << " is out of range for a dictionary of " << count << " values";
+      throw invalid_argument(ss.str());
+    }
+
+    return values.cdata() + code * values_md->stride;
+  };
+
+  if (!fixed_layout) {
+    // The repeated strings are built in one arena rather than allocated one by one
+    vector<const char *> begins(codes_md->dim_size), ends(codes_md->dim_size);
+    for (intptr_t i = 0; i < codes_md->dim_size; ++i) {
+      const dynd::string *value = reinterpret_cast<const dynd::string *>(get_value(i));
+      begins[i] = value->begin();
+      ends[i] = value->end();
+    }
+
+    return nd::make_string_array(codes_md->dim_size, begins.data(), ends.data());
+  }
+
+  nd::array res = nd::empty(codes_md->dim_size, element_tp);
+  intptr_t res_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res.get()->metadata())->stride;
+  char *res_data = res.data();
+  for (intptr_t i = 0; i < codes_md->dim_size; ++i) {
+    memcpy(res_data + i * res_stride, get_value(i), element_size);
+  }
+
+  return res;
+}
+
+nd::array call_on_dictionary(const nd::callable &f, const nd::array &dictionary, std::initializer_list<nd::array> args,
+                             std::initializer_list<std::pair<const char *, nd::array>> kwds, const char *name) {
+  vector<nd::array> all_args{dictionary};
+  all_args.insert(all_args.end(), args.begin(), args.end());
+  nd::array res = f.call(all_args.size(), all_args.data(), kwds.size(), kwds.begin());
+
+  if (res.get_type().get_id() != fixed_dim_id || res.get_dim_size() != dictionary.get_dim_size()) {
+    stringstream ss;
+    ss << name << ": the function must return one value per dictionary entry, but returned an array of type "
+       << res.get_type();
+    throw invalid_argument(ss.str());
+  }
+
+  return res;
+}
+
+} // anonymous namespace
+
+nd::array nd::dictionary_encode(const array &values) {
+  if (get_element_type(values, "dictionary_encode").get_id() != string_id) {
+    stringstream ss;
+    ss << "dictionary_encode: expected an array of strings, not one of type " << values.get_type();
+    throw type_error(ss.str());
+  }
+
+  typedef detail::unique_traits<dynd::string> traits;
+  const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(values.get()->metadata());
+  intptr_t size = md->dim_size;
+
+  array codes = empty(size, ndt::make_type<uint32_t>());
+  uint32_t *codes_data = reinterpret_cast<uint32_t *>(codes.data());
+
+  // An open addressing table of indices into the distinct values, which
+  // grows with their number rather than with the number of elements
+  vector<uint32_t> table(64, empty_slot);
+  vector<const dynd::string *> distinct;
+  vector<uint64_t> hashes;
+  for (intptr_t i = 0; i < size; ++i) {
+    const dynd::string &value = *reinterpret_cast<const dynd::string *>(values.cdata() + i * md->stride);
+    uint64_t hash = traits::hash(value);
+    size_t mask = table.size() - 1;
+    size_t slot = static_cast<size_t>(hash) & mask;
+    while (table[slot] != empty_slot && !traits::equal(*distinct[table[slot]], value)) {
+      slot = (slot + 1) & mask;
+    }
+
+    uint32_t code = table[slot];
+    if (code == empty_slot) {
+      if (distinct.size() == empty_slot) {
+        throw overflow_error("dictionary_encode: too many distinct values for uint32 codes");
+      }
+      code = static_cast<uint32_t>(distinct.size());
+      table[slot] = code;
+      distinct.push_back(&value);
+      hashes.push_back(hash);
+
+      // Keep the load factor at or below one half
+      if (2 * distinct.size() > table.size()) {
+        table.assign(2 * table.size(), empty_slot);
+        mask = table.size() - 1;
+        for (uint32_t j = 0; j < distinct.size(); ++j) {
+          size_t new_slot = static_cast<size_t>(hashes[j]) & mask;
+          while (table[new_slot] != empty_slot) {
+            new_slot = (new_slot + 1) & mask;
+          }
+          table[new_slot] = j;
+        }
+      }
+    }
+    codes_data[i] = code;
+  }
+
+  array dictionary = empty(distinct.size(), ndt::make_type<ndt::string_type>());
+  intptr_t dictionary_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(dictionary.get()->metadata())->stride;
+  for (size_t j = 0; j < distinct.size(); ++j) {
+    *reinterpret_cast<dynd::string *>(dictionary.data() + j * dictionary_stride) = *distinct[j];
+  }
+
+  return as_struct({{"codes", codes}, {"dictionary", dictionary}});
+}
+
+nd::array nd::dictionary_decode(const array &encoded) {
+  array codes, dictionary;
+  check_encoded(encoded, codes, dictionary, "dictionary_decode");
+  return gather(dictionary, codes, "dictionary_decode");
+}
+
+nd::array nd::dictionary_map(const callable &f, const array &encoded, std::initializer_list<array> args,
+                             std::initializer_list<std::pair<const char *, array>> kwds) {
+  array codes, dictionary;
+  check_encoded(encoded, codes, dictionary, "dictionary_map");
+  return gather(call_on_dictionary(f, dictionary, args, kwds, "dictionary_map"), codes, "dictionary_map");
+}
+
+nd::array nd::dictionary_transform(const callable &f, const array &encoded, std::initializer_list<array> args,
+                                   std::initializer_list<std::pair<const char *, array>> kwds) {
+  array codes, dictionary;
+  check_encoded(encoded, codes, dictionary, "dictionary_transform");
+  array res = call_on_dictionary(f, dictionary, args, kwds, "dictionary_transform");
+  return as_struct({{"codes", codes}, {"dictionary", res}});
+}
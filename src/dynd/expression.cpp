@@ -0,0 +1,127 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/callables/fused_callable.hpp>
+#include <dynd/expression.hpp>
+#include <dynd/functional.hpp>
+
+using namespace std;
+using namespace dynd;
+
+nd::expression::expression(const array &value) : m_node(make_shared<node>(node{value, callable(), {}})) {}
+
+nd::expression::expression(const callable &func, std::initializer_list<expression> args)
+    : expression(func, std::vector<expression>(args)) {}
+
+nd::expression::expression(const callable &func, const std::vector<expression> &args)
+    : m_node(make_shared<node>(node{array(), func, args})) {
+  if (func.is_null()) {
+    throw invalid_argument("cannot make an expression with a null callable");
+  }
+}
+
+intptr_t nd::expression::flatten(std::vector<array> &leaves, std::vector<callable> &children,
+                                 std::vector<std::vector<intptr_t>> &child_args) const {
+  if (is_leaf()) {
+    leaves.push_back(m_node->value);
+    return -static_cast<intptr_t>(leaves.size());
+  }
+
+  std::vector<intptr_t> args;
+  for (const expression &arg : m_node->args) {
+    args.push_back(arg.flatten(leaves, children, child_args));
+  }
+
+  children.push_back(m_node->func);
+  child_args.push_back(args);
+  return children.size() - 1;
+}
+
+nd::array nd::expression::eval_unfused() const {
+  if (is_leaf()) {
+    return m_node->value;
+  }
+
+  std::vector<array> args;
+  for (const expression &arg : m_node->args) {
+    args.push_back(arg.eval_unfused());
+  }
+
+  return m_node->func.call(args.size(), args.data(), 0, nullptr);
+}
+
+nd::array nd::expression::eval() const {
+  if (is_leaf()) {
+    return m_node->value;
+  }
+
+  std::vector<array> leaves;
+  std::vector<callable> children;
+  std::vector<std::vector<intptr_t>> child_args;
+  flatten(leaves, children, child_args);
+
+  // The lifted kernel supports a limited number of arguments
+  size_t nsrc = leaves.size();
+  if (nsrc == 0 || nsrc > nd::functional::fused_kernel::max_nsrc) {
+    return eval_unfused();
+  }
+
+  // Leaves are slots [0, nsrc), and the result of step i is slot nsrc + i
+  std::vector<ndt::type> slot_tp;
+  for (const array &leaf : leaves) {
+    slot_tp.push_back(leaf.get_dtype());
+  }
+
+  std::vector<intptr_t> arg_slot;
+  std::vector<size_t> arg_begin{0};
+  std::vector<ndt::type> buffer_tp;
+  ndt::type ret_tp;
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (children[i]->get_nkwd() != 0) {
+      return eval_unfused();
+    }
+
+    std::vector<ndt::type> child_src_tp;
+    for (intptr_t arg : child_args[i]) {
+      intptr_t slot = (arg < 0) ? (-arg - 1) : (nsrc + arg);
+      arg_slot.push_back(slot);
+      child_src_tp.push_back(slot_tp[slot]);
+    }
+    arg_begin.push_back(arg_slot.size());
+
+    ret_tp = children[i].resolve(children[i]->get_ret_type(), child_src_tp.size(), child_src_tp.data(), 0, nullptr);
+    if (i + 1 < children.size()) {
+      if (!ret_tp.is_builtin()) {
+        return eval_unfused();
+      }
+      buffer_tp.push_back(ret_tp);
+    }
+    slot_tp.push_back(ret_tp);
+  }
+
+  if (ret_tp.is_symbolic()) {
+    return eval_unfused();
+  }
+
+  callable f = functional::elwise(make_callable<functional::fused_callable>(
+      ndt::make_type<ndt::callable_type>(ret_tp, std::vector<ndt::type>(slot_tp.begin(), slot_tp.begin() + nsrc)),
+      children, arg_slot, arg_begin, buffer_tp));
+  return f.call(nsrc, leaves.data(), 0, nullptr);
+}
+
+nd::expression nd::operator-(const expression &a0) { return expression(minus, {a0}); }
+
+nd::expression nd::operator+(const expression &op0, const expression &op1) { return expression(add, {op0, op1}); }
+
+nd::expression nd::operator-(const expression &op0, const expression &op1) {
+  return expression(subtract, {op0, op1});
+}
+
+nd::expression nd::operator*(const expression &op0, const expression &op1) {
+  return expression(multiply, {op0, op1});
+}
+
+nd::expression nd::operator/(const expression &op0, const expression &op1) { return expression(divide, {op0, op1}); }
@@ -172,7 +172,8 @@ nd::callable nd::functional::neighborhood(const callable &neighborhood_op, const
       neighborhood_op, boundary_child);
 }
 
-nd::callable nd::functional::reduction(const callable &identity, const callable &child) {
+nd::callable nd::functional::reduction(const callable &identity, const callable &child,
+                                       callable_property properties) {
   if (identity.is_null()) {
     throw invalid_argument("'identity' cannot be null");
   }
@@ -193,7 +194,7 @@ nd::callable nd::functional::reduction(const callable &identity, const callable
   return make_callable<reduction_dispatch_callable>(
       ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::ellipsis_dim_type>("Dims", child->get_ret_type()),
                                          arg_tp.size(), arg_tp.data(), kwds),
-      identity, child);
+      identity, child, properties);
 }
 
 nd::callable nd::functional::where(const callable &child) { return elwise(make_callable<where_callable>(child), true); }
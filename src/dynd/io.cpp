@@ -3,12 +3,373 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <dynd/arrmeta_holder.hpp>
 #include <dynd/callables/serialize_callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/io.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/types/bytes_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 using namespace std;
 using namespace dynd;
 
 DYND_API nd::callable nd::serialize = nd::functional::reduction(
     [] { return bytes(); }, nd::make_callable<nd::serialize_callable<ndt::scalar_kind_type>>());
+
+namespace {
+
+const char binary_magic[4] = {'D', 'Y', 'N', 'D'};
+const uint16_t binary_version = 1;
+// Written in native byte order, so a file from a machine with the other one
+// reads back as 0x0201
+const uint16_t binary_byte_order = 0x0102;
+// The data starts at a multiple of this, and so does every variable-sized
+// piece of it
+const size_t binary_alignment = 64;
+
+struct binary_header {
+  char magic[4];
+  uint16_t version;
+  uint16_t byte_order;
+  uint64_t type_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+// How a string or a var_dim element is stored in the file, in place of the
+// pointer and size it has in memory
+struct binary_extent {
+  uint64_t offset;
+  uint64_t size;
+};
+
+bool is_fixed_layout(const ndt::type &tp) {
+  return tp.is_builtin() || (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) == 0;
+}
+
+size_t align_up(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+template <typename BytesType>
+void write_binary_bytes(const BytesType &s, vector<char> &out, size_t dst) {
+  binary_extent extent;
+  extent.offset = out.size();
+  extent.size = s.size();
+  out.insert(out.end(), s.begin(), s.end());
+  memcpy(out.data() + dst, &extent, sizeof(extent));
+}
+
+/**
+ * Gets the fields of a tuple or struct type, which do not share a base class.
+ */
+void get_fields(const ndt::type &tp, intptr_t &field_count, const ndt::type *&field_tps,
+                const uintptr_t *&arrmeta_offsets) {
+  if (tp.get_id() == struct_id) {
+    const ndt::struct_type *st = tp.extended<ndt::struct_type>();
+    field_count = st->get_field_count();
+    field_tps = st->get_field_types_raw();
+    arrmeta_offsets = st->get_arrmeta_offsets_raw();
+  } else {
+    const ndt::tuple_type *tt = tp.extended<ndt::tuple_type>();
+    field_count = tt->get_field_count();
+    field_tps = tt->get_field_types_raw();
+    arrmeta_offsets = tt->get_arrmeta_offsets_raw();
+  }
+}
+
+/**
+ * Copies a value of type ``tp`` into ``out`` at ``dst``, laid out with the
+ * default arrmeta ``dst_arrmeta``. Strings and the elements of var_dims are
+ * appended to ``out``, and their offsets and sizes take the place of their
+ * pointers.
+ */
+void write_binary_value(const ndt::type &tp, const char *src_arrmeta, const char *src, const char *dst_arrmeta,
+                        vector<char> &out, size_t dst) {
+  switch (tp.get_id()) {
+  case fixed_dim_id: {
+    const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    const fixed_dim_type_arrmeta *src_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta);
+    const fixed_dim_type_arrmeta *dst_md = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta);
+    if (el_tp.is_builtin() && src_md->stride == dst_md->stride) {
+      memcpy(out.data() + dst, src, src_md->dim_size * src_md->stride);
+      return;
+    }
+    for (intptr_t i = 0; i < src_md->dim_size; ++i) {
+      write_binary_value(el_tp, src_arrmeta + sizeof(fixed_dim_type_arrmeta), src + i * src_md->stride,
+                         dst_arrmeta + sizeof(fixed_dim_type_arrmeta), out, dst + i * dst_md->stride);
+    }
+    return;
+  }
+  case var_dim_id: {
+    const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+    const ndt::var_dim_type::metadata_type *src_md =
+        reinterpret_cast<const ndt::var_dim_type::metadata_type *>(src_arrmeta);
+    const ndt::var_dim_type::metadata_type *dst_md =
+        reinterpret_cast<const ndt::var_dim_type::metadata_type *>(dst_arrmeta);
+    const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(src);
+
+    binary_extent extent;
+    extent.offset = align_up(out.size(), binary_alignment);
+    extent.size = d->size;
+    out.resize(extent.offset + d->size * dst_md->stride);
+    memcpy(out.data() + dst, &extent, sizeof(extent));
+    for (size_t i = 0; i < d->size; ++i) {
+      write_binary_value(el_tp, src_arrmeta + sizeof(ndt::var_dim_type::metadata_type),
+                         d->begin + src_md->offset + i * src_md->stride,
+                         dst_arrmeta + sizeof(ndt::var_dim_type::metadata_type), out,
+                         extent.offset + i * dst_md->stride);
+    }
+    return;
+  }
+  case string_id:
+    write_binary_bytes(*reinterpret_cast<const dynd::string *>(src), out, dst);
+    return;
+  case bytes_id:
+    write_binary_bytes(*reinterpret_cast<const bytes *>(src), out, dst);
+    return;
+  case option_id:
+    write_binary_value(tp.extended<ndt::option_type>()->get_value_type(), src_arrmeta, src, dst_arrmeta, out, dst);
+    return;
+  case tuple_id:
+  case struct_id: {
+    intptr_t field_count;
+    const ndt::type *field_tps;
+    const uintptr_t *arrmeta_offsets;
+    get_fields(tp, field_count, field_tps, arrmeta_offsets);
+    const uintptr_t *src_offsets = reinterpret_cast<const uintptr_t *>(src_arrmeta);
+    const uintptr_t *dst_offsets = reinterpret_cast<const uintptr_t *>(dst_arrmeta);
+    for (intptr_t i = 0; i < field_count; ++i) {
+      write_binary_value(field_tps[i], src_arrmeta + arrmeta_offsets[i], src + src_offsets[i],
+                         dst_arrmeta + arrmeta_offsets[i], out, dst + dst_offsets[i]);
+    }
+    return;
+  }
+  default:
+    if (is_fixed_layout(tp) && tp.get_ndim() == 0) {
+      memcpy(out.data() + dst, src, tp.get_data_size());
+      return;
+    }
+    break;
+  }
+
+  stringstream ss;
+  ss << "cannot write dynd type " << tp << " in the binary format";
+  throw type_error(ss.str());
+}
+
+void check_extent(const binary_extent &extent, size_t element_size, size_t data_size) {
+  if (extent.offset > data_size || extent.size > (data_size - extent.offset) / max<size_t>(element_size, 1)) {
+    throw runtime_error("dynd binary data is corrupt: an extent is out of bounds");
+  }
+}
+
+template <typename BytesType>
+void read_binary_bytes(BytesType *dst, const char *data, size_t data_size, size_t src) {
+  binary_extent extent;
+  memcpy(&extent, data + src, sizeof(extent));
+  check_extent(extent, 1, data_size);
+  dst->assign(data + extent.offset, extent.size);
+}
+
+/**
+ * Copies a value of type ``tp`` from the binary ``data`` at ``src`` into
+ * ``dst``, which has the default arrmeta ``arrmeta``. That is also the
+ * layout of the value in the binary data.
+ */
+void read_binary_value(const ndt::type &tp, const char *arrmeta, char *dst, const char *data, size_t data_size,
+                       size_t src) {
+  switch (tp.get_id()) {
+  case fixed_dim_id: {
+    const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+    if (is_fixed_layout(el_tp)) {
+      memcpy(dst, data + src, md->dim_size * md->stride);
+      return;
+    }
+    for (intptr_t i = 0; i < md->dim_size; ++i) {
+      read_binary_value(el_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), dst + i * md->stride, data, data_size,
+                        src + i * md->stride);
+    }
+    return;
+  }
+  case var_dim_id: {
+    const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    ndt::var_dim_type::data_type *d = reinterpret_cast<ndt::var_dim_type::data_type *>(dst);
+
+    binary_extent extent;
+    memcpy(&extent, data + src, sizeof(extent));
+    check_extent(extent, md->stride, data_size);
+    d->begin = md->blockref->alloc(extent.size);
+    d->size = extent.size;
+    if (is_fixed_layout(el_tp)) {
+      memcpy(d->begin, data + extent.offset, extent.size * md->stride);
+      return;
+    }
+    for (size_t i = 0; i < extent.size; ++i) {
+      read_binary_value(el_tp, arrmeta + sizeof(ndt::var_dim_type::metadata_type), d->begin + i * md->stride, data,
+                        data_size, extent.offset + i * md->stride);
+    }
+    return;
+  }
+  case string_id:
+    read_binary_bytes(reinterpret_cast<dynd::string *>(dst), data, data_size, src);
+    return;
+  case bytes_id:
+    read_binary_bytes(reinterpret_cast<bytes *>(dst), data, data_size, src);
+    return;
+  case option_id:
+    read_binary_value(tp.extended<ndt::option_type>()->get_value_type(), arrmeta, dst, data, data_size, src);
+    return;
+  case tuple_id:
+  case struct_id: {
+    intptr_t field_count;
+    const ndt::type *field_tps;
+    const uintptr_t *arrmeta_offsets;
+    get_fields(tp, field_count, field_tps, arrmeta_offsets);
+    const uintptr_t *offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    for (intptr_t i = 0; i < field_count; ++i) {
+      read_binary_value(field_tps[i], arrmeta + arrmeta_offsets[i], dst + offsets[i], data, data_size,
+                        src + offsets[i]);
+    }
+    return;
+  }
+  default:
+    if (!is_fixed_layout(tp)) {
+      stringstream ss;
+      ss << "cannot read dynd type " << tp << " from the binary format";
+      throw type_error(ss.str());
+    }
+    memcpy(dst, data + src, tp.get_data_size());
+    return;
+  }
+}
+
+/**
+ * Validates the header at the start of [begin, end), returning the type and
+ * the bounds of the data.
+ */
+ndt::type read_binary_header(const char *begin, const char *end, const char *&data_begin, const char *&data_end) {
+  binary_header header;
+  if (static_cast<size_t>(end - begin) < sizeof(header)) {
+    throw runtime_error("dynd binary data is too short for its header");
+  }
+  memcpy(&header, begin, sizeof(header));
+  if (memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0) {
+    throw runtime_error("data is not in the dynd binary format");
+  }
+  if (header.byte_order != binary_byte_order) {
+    throw runtime_error("dynd binary data was written with a different byte order");
+  }
+  if (header.version != binary_version) {
+    stringstream ss;
+    ss << "unsupported dynd binary format version " << header.version;
+    throw runtime_error(ss.str());
+  }
+
+  size_t size = end - begin;
+  if (header.type_size > size - sizeof(header) || header.data_offset < sizeof(header) + header.type_size ||
+      header.data_offset > size || header.data_size > size - header.data_offset) {
+    throw runtime_error("dynd binary data is truncated");
+  }
+
+  const char *type_begin = begin + sizeof(header);
+  ndt::type tp(std::string(type_begin, type_begin + header.type_size));
+  if (tp.is_symbolic() || header.data_size < tp.get_default_data_size()) {
+    throw runtime_error("dynd binary data is corrupt: the type does not match the data");
+  }
+
+  data_begin = begin + header.data_offset;
+  data_end = data_begin + header.data_size;
+  return tp;
+}
+
+nd::array read_binary_copy(const ndt::type &tp, const char *data_begin, const char *data_end) {
+  nd::array res = nd::empty(tp);
+  read_binary_value(tp, res.get()->metadata(), res.data(), data_begin, data_end - data_begin, 0);
+  res.get_type().extended()->arrmeta_finalize_buffers(res.get()->metadata());
+  return res;
+}
+
+} // anonymous namespace
+
+void nd::write_binary(std::ostream &o, const array &a) {
+  array src = a.get_type().is_expression() ? a.eval() : a;
+  const ndt::type &tp = src.get_type();
+  if (tp.is_symbolic()) {
+    stringstream ss;
+    ss << "cannot write dynd type " << tp << " in the binary format";
+    throw type_error(ss.str());
+  }
+
+  arrmeta_holder layout(tp);
+  layout.arrmeta_default_construct(false);
+  vector<char> data(tp.get_default_data_size());
+  write_binary_value(tp, src.get()->metadata(), src.cdata(), layout.get(), data, 0);
+
+  stringstream type_ss;
+  type_ss << tp;
+  std::string type_str = type_ss.str();
+
+  binary_header header;
+  memcpy(header.magic, binary_magic, sizeof(binary_magic));
+  header.version = binary_version;
+  header.byte_order = binary_byte_order;
+  header.type_size = type_str.size();
+  header.data_offset = align_up(sizeof(header) + type_str.size(), binary_alignment);
+  header.data_size = data.size();
+
+  char padding[binary_alignment] = {0};
+  o.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  o.write(type_str.data(), type_str.size());
+  o.write(padding, header.data_offset - sizeof(header) - type_str.size());
+  o.write(data.data(), data.size());
+  if (!o.good()) {
+    throw runtime_error("error writing dynd binary data to the stream");
+  }
+}
+
+void nd::save_binary(const std::string &filename, const array &a) {
+  ofstream o(filename.c_str(), ios::binary | ios::trunc);
+  if (!o.is_open()) {
+    stringstream ss;
+    ss << "failed to open file \"" << filename << "\" for writing";
+    throw runtime_error(ss.str());
+  }
+  write_binary(o, a);
+}
+
+nd::array nd::read_binary(const char *begin, const char *end) {
+  const char *data_begin, *data_end;
+  ndt::type tp = read_binary_header(begin, end, data_begin, data_end);
+  return read_binary_copy(tp, data_begin, data_end);
+}
+
+nd::array nd::load_binary(const std::string &filename) {
+  char *begin = NULL;
+  intptr_t size = 0;
+  memory_block mm = make_memory_block<memmap_memory_block>(filename, read_access_flag, &begin, &size);
+
+  const char *data_begin, *data_end;
+  ndt::type tp = read_binary_header(begin, begin + size, data_begin, data_end);
+  if (!is_fixed_layout(tp)) {
+    return read_binary_copy(tp, data_begin, data_end);
+  }
+
+  // The data has the default layout of the type, so the array can view the
+  // mapping directly, keeping it alive
+  array res = make_array(tp, const_cast<char *>(data_begin), mm, read_access_flag | immutable_access_flag);
+  if (tp.get_arrmeta_size() > 0) {
+    tp.extended()->arrmeta_default_construct(res.get()->metadata(), false);
+  }
+  return res;
+}
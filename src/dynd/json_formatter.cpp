@@ -3,6 +3,18 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <dynd/json_formatter.hpp>
 #include <dynd/callable.hpp>
 #include <dynd/option.hpp>
@@ -15,56 +27,114 @@
 using namespace std;
 using namespace dynd;
 
-struct output_data {
-  dynd::string out_string;
-  char *out_begin, *out_end, *out_capacity_end;
-  bool struct_as_list;
+json_buffer::json_buffer() : m_begin(NULL), m_end(NULL), m_capacity_end(NULL), m_fd(-1), m_flush_size(0) {}
 
-  void ensure_capacity(intptr_t added_capacity) {
-    // If there's not enough space, double the capacity
-    if (out_capacity_end - out_end < added_capacity) {
-      intptr_t current_size = out_end - out_begin;
-      intptr_t new_capacity = 2 * (out_capacity_end - out_begin);
-      // Make sure this adds the requested additional capacity
-      if (new_capacity < current_size + added_capacity) {
-        new_capacity = current_size + added_capacity;
-      }
-      out_string.resize(new_capacity);
-      out_begin = out_string.begin();
-      out_capacity_end = out_begin + new_capacity;
-      out_end = out_begin + current_size;
+json_buffer::json_buffer(int fd, size_t flush_size)
+    : m_begin(NULL), m_end(NULL), m_capacity_end(NULL), m_fd(fd), m_flush_size(flush_size) {}
+
+json_buffer::~json_buffer() {
+  try {
+    flush();
+  } catch (...) {
+  }
+  free(m_begin);
+}
+
+void json_buffer::grow(size_t added_size) {
+  if (m_fd != -1 && size() + added_size > m_flush_size) {
+    flush();
+    if (static_cast<size_t>(m_capacity_end - m_end) >= added_size) {
+      return;
     }
   }
 
-  inline void write(char c) {
-    ensure_capacity(1);
-    *out_end++ = c;
+  // Double the capacity, making sure this adds the requested amount. A
+  // buffer that writes to a file descriptor stays at its flush size unless a
+  // single write needs more, so that running out of space is what flushes it.
+  size_t current_size = size();
+  size_t new_capacity = m_fd != -1 ? m_flush_size : std::max<size_t>(2 * (m_capacity_end - m_begin), 1024);
+  if (new_capacity < current_size + added_size) {
+    new_capacity = current_size + added_size;
   }
+  char *new_begin = reinterpret_cast<char *>(realloc(m_begin, new_capacity));
+  if (new_begin == NULL) {
+    throw bad_alloc();
+  }
+  m_begin = new_begin;
+  m_end = new_begin + current_size;
+  m_capacity_end = new_begin + new_capacity;
+}
 
-  // Write a literal string
-  template <int N>
-  inline void write(const char(&str)[N]) {
-    ensure_capacity(N - 1);
-    memcpy(out_end, str, N - 1);
-    out_end += N - 1;
+void json_buffer::flush() {
+  if (m_fd == -1) {
+    return;
   }
 
-  // Write a std::string
-  inline void write(const std::string &s) {
-    ensure_capacity(s.size());
-    memcpy(out_end, s.data(), s.size());
-    out_end += s.size();
+  const char *begin = m_begin;
+  while (begin < m_end) {
+#ifdef _WIN32
+    int count = _write(m_fd, begin, static_cast<unsigned int>(std::min<size_t>(m_end - begin, INT_MAX)));
+#else
+    ssize_t count = ::write(m_fd, begin, m_end - begin);
+#endif
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Keep what was not written, so that a later flush can retry
+      memmove(m_begin, begin, m_end - begin);
+      m_end = m_begin + (m_end - begin);
+      stringstream ss;
+      ss << "json_buffer: error writing to file descriptor " << m_fd << ": " << strerror(errno);
+      throw runtime_error(ss.str());
+    }
+    begin += count;
   }
+  m_end = m_begin;
+}
 
-  // Write a string-range
-  inline void write(const char *begin, const char *end) {
-    ensure_capacity(end - begin);
-    memcpy(out_end, begin, end - begin);
-    out_end += (end - begin);
+// The buffer together with the options of one call to format_json
+struct output_data {
+  json_buffer &buf;
+  bool struct_as_list;
+
+  void write(char c) { buf.write(c); }
+
+  template <int N>
+  void write(const char(&str)[N]) {
+    buf.write(str);
   }
+
+  void write(const std::string &s) { buf.write(s); }
+
+  void write(const char *begin, const char *end) { buf.write(begin, end); }
 };
 
 static void format_json(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data);
+static void format_json_encoded_string(output_data &out, const char *begin, const char *end,
+                                       string_encoding_t encoding);
+
+const std::vector<std::string> &json_buffer::get_field_prefixes(const ndt::type &tp) {
+  auto it = m_field_prefixes.find(tp.extended());
+  if (it != m_field_prefixes.end()) {
+    return it->second.second;
+  }
+
+  const ndt::struct_type *sd = tp.extended<ndt::struct_type>();
+  std::vector<std::string> prefixes;
+  json_buffer prefix;
+  output_data prefix_out = {prefix, false};
+  for (intptr_t i = 0; i < sd->get_field_count(); ++i) {
+    const std::string &name = sd->get_field_name(i);
+    prefix.clear();
+    prefix_out.write(i == 0 ? '{' : ',');
+    format_json_encoded_string(prefix_out, name.data(), name.data() + name.size(), string_encoding_utf_8);
+    prefix_out.write(':');
+    prefixes.push_back(prefix.str());
+  }
+
+  return m_field_prefixes.emplace(tp.extended(), make_pair(tp, std::move(prefixes))).first->second.second;
+}
 
 static void format_json_bool(output_data &out, const ndt::type &dt, const char *DYND_UNUSED(arrmeta),
                              const char *data) {
@@ -81,7 +151,116 @@ static void format_json_bool(output_data &out, const ndt::type &dt, const char *
   }
 }
 
+static const char digit_pairs[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+
+// Formats the digits two at a time from the back of a small buffer
+static void format_json_uint(output_data &out, uint64_t value, bool negative) {
+  char buffer[24];
+  char *begin = buffer + sizeof(buffer);
+  while (value >= 100) {
+    begin -= 2;
+    memcpy(begin, digit_pairs + 2 * (value % 100), 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    begin -= 2;
+    memcpy(begin, digit_pairs + 2 * value, 2);
+  } else {
+    *--begin = static_cast<char>('0' + value);
+  }
+  if (negative) {
+    *--begin = '-';
+  }
+
+  out.write(begin, buffer + sizeof(buffer));
+}
+
+template <typename T>
+static void format_json_int(output_data &out, const char *data) {
+  T value = *reinterpret_cast<const T *>(data);
+  if (value < 0) {
+    // Negating in unsigned arithmetic also handles the most negative value
+    format_json_uint(out, static_cast<uint64_t>(0) - static_cast<uint64_t>(value), true);
+  } else {
+    format_json_uint(out, static_cast<uint64_t>(value), false);
+  }
+}
+
+/**
+ * Formats a finite floating point value with the fewest significant digits,
+ * between ``min_digits`` and ``max_digits``, that parse back to the same
+ * value. Any value with no more than ``min_digits`` digits in its shortest
+ * form comes out of the first attempt.
+ */
+template <typename T>
+static void format_json_float(output_data &out, T value, int min_digits, int max_digits) {
+  char buffer[32];
+  int size = 0;
+  for (int digits = min_digits; digits <= max_digits; ++digits) {
+    size = snprintf(buffer, sizeof(buffer), "%.*g", digits, static_cast<double>(value));
+    if (digits == max_digits || static_cast<T>(strtod(buffer, NULL)) == value) {
+      break;
+    }
+  }
+
+  out.write(buffer, buffer + size);
+}
+
 static void format_json_number(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data) {
+  switch (dt.get_id()) {
+  case int8_id:
+    format_json_int<int8_t>(out, data);
+    return;
+  case int16_id:
+    format_json_int<int16_t>(out, data);
+    return;
+  case int32_id:
+    format_json_int<int32_t>(out, data);
+    return;
+  case int64_id:
+    format_json_int<int64_t>(out, data);
+    return;
+  case uint8_id:
+    format_json_int<uint8_t>(out, data);
+    return;
+  case uint16_id:
+    format_json_int<uint16_t>(out, data);
+    return;
+  case uint32_id:
+    format_json_int<uint32_t>(out, data);
+    return;
+  case uint64_id:
+    format_json_int<uint64_t>(out, data);
+    return;
+  case float32_id: {
+    float value = *reinterpret_cast<const float *>(data);
+    if (std::isfinite(value)) {
+      format_json_float(out, value, 6, 9);
+      return;
+    }
+    break;
+  }
+  case float64_id: {
+    double value = *reinterpret_cast<const double *>(data);
+    if (std::isfinite(value)) {
+      format_json_float(out, value, 15, 17);
+      return;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
   stringstream ss;
   dt.print_data(ss, arrmeta, data);
   out.write(ss.str());
@@ -126,8 +305,10 @@ static void print_escaped_unicode_codepoint(output_data &out, uint32_t cp, appen
       break;
     }
   } else {
-    out.ensure_capacity(16);
-    append_fn(cp, out.out_end, out.out_capacity_end);
+    char buffer[8];
+    char *end = buffer;
+    append_fn(cp, end, buffer + sizeof(buffer));
+    out.write(buffer, end);
   }
   // TODO: Could have an ASCII output mode where unicode is always escaped
   /*
@@ -145,6 +326,8 @@ static void print_escaped_unicode_codepoint(output_data &out, uint32_t cp, appen
   */
 }
 
+static bool is_plain_json_char(char c) { return c >= 0x20 && c < 0x7f && c != '\"' && c != '\\' && c != '/'; }
+
 static void format_json_encoded_string(output_data &out, const char *begin, const char *end,
                                        string_encoding_t encoding) {
   uint32_t cp;
@@ -154,6 +337,18 @@ static void format_json_encoded_string(output_data &out, const char *begin, cons
   append_fn = get_append_unicode_codepoint_function(string_encoding_utf_8, assign_error_nocheck);
   out.write('\"');
   while (begin < end) {
+    if (encoding == string_encoding_utf_8 || encoding == string_encoding_ascii) {
+      // Copy runs of ASCII characters that need no escaping at once
+      const char *run_end = begin;
+      while (run_end < end && is_plain_json_char(*run_end)) {
+        ++run_end;
+      }
+      out.write(begin, run_end);
+      begin = run_end;
+      if (begin == end) {
+        break;
+      }
+    }
     cp = next_fn(begin, end);
     print_escaped_unicode_codepoint(out, cp, append_fn);
   }
@@ -210,15 +405,13 @@ static void format_json_struct(output_data &out, const ndt::type &dt, const char
     }
     out.write(']');
   } else {
-    out.write('{');
+    const std::vector<std::string> &prefixes = out.buf.get_field_prefixes(dt);
+    if (field_count == 0) {
+      out.write('{');
+    }
     for (intptr_t i = 0; i < field_count; ++i) {
-      const std::string &name = bsd->get_field_name(i);
-      format_json_encoded_string(out, name.data(), name.data() + name.size(), string_encoding_utf_8);
-      out.write(':');
+      out.write(prefixes[i]);
       ::format_json(out, bsd->get_field_type(i), arrmeta + arrmeta_offsets[i], data + data_offsets[i]);
-      if (i != field_count - 1) {
-        out.write(',');
-      }
     }
     out.write('}');
   }
@@ -314,28 +507,27 @@ static void format_json(output_data &out, const ndt::type &dt, const char *arrme
   }
 }
 
-nd::array dynd::format_json(const nd::array &n, bool struct_as_list) {
-  // Create a UTF-8 string
-  nd::array result = nd::empty(ndt::make_type<ndt::string_type>());
-
-  // Initialize the output with some memory
-  output_data out;
-  out.out_string.resize(1024);
-  out.out_begin = out.out_string.begin();
-  out.out_capacity_end = out.out_string.end();
-  out.out_end = out.out_begin;
-  out.struct_as_list = struct_as_list;
-
+void dynd::format_json(json_buffer &buf, const nd::array &n, bool struct_as_list) {
+  output_data out = {buf, struct_as_list};
   if (!n.get_type().is_expression()) {
     ::format_json(out, n.get_type(), n.get()->metadata(), n.cdata());
   } else {
     nd::array tmp = n.eval();
     ::format_json(out, tmp.get_type(), tmp.get()->metadata(), tmp.cdata());
   }
+}
+
+nd::array dynd::format_json(const nd::array &n, bool struct_as_list) {
+  // Reuse the memory and the field prefixes of the calling thread's buffer
+  thread_local json_buffer out;
+  out.clear();
+  out.clear_field_prefixes(64);
+  format_json(out, n, struct_as_list);
 
-  // Shrink the memory to fit, and set the pointers in the output
+  // Create a UTF-8 string
+  nd::array result = nd::empty(ndt::make_type<ndt::string_type>());
   string *d = reinterpret_cast<string *>(result.data());
-  d->assign(out.out_string.data(), out.out_end - out.out_begin);
+  d->assign(out.data(), out.size());
 
   // Finalize processing and mark the result as immutable
   result.get_type().extended()->arrmeta_finalize_buffers(result.get()->metadata());
@@ -0,0 +1,273 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/json_index.hpp>
+#include <dynd/kernels/simd.hpp>
+#include <dynd/parse_util.hpp>
+
+#ifdef DYND_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/**
+ * One bit per byte of a 64 byte block for each class of character that the
+ * index cares about.
+ */
+struct block_masks {
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t op;
+};
+
+block_masks classify_scalar(const char *block) {
+  block_masks res = {0, 0, 0};
+  for (int i = 0; i < 64; ++i) {
+    uint64_t bit = static_cast<uint64_t>(1) << i;
+    switch (block[i]) {
+    case '"':
+      res.quote |= bit;
+      break;
+    case '\\':
+      res.backslash |= bit;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      res.op |= bit;
+      break;
+    default:
+      break;
+    }
+  }
+
+  return res;
+}
+
+#ifdef DYND_SIMD_DISPATCH
+
+// Setting bit 5 maps '[' (0x5b) to '{' (0x7b) and ']' (0x5d) to '}' (0x7d),
+// so two comparisons find all the brackets and braces
+
+DYND_SIMD_TARGET("sse2") block_masks classify_sse2(const char *block) {
+  const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), bit5 = _mm_set1_epi8(0x20),
+                open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}'), colon = _mm_set1_epi8(':'),
+                comma = _mm_set1_epi8(',');
+
+  block_masks res = {0, 0, 0};
+  for (int i = 0; i < 4; ++i) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+    __m128i folded = _mm_or_si128(v, bit5);
+    __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                              _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+    res.quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << (16 * i);
+    res.backslash |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash))))
+                     << (16 * i);
+    res.op |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(op))) << (16 * i);
+  }
+
+  return res;
+}
+
+DYND_SIMD_TARGET("avx2") block_masks classify_avx2(const char *block) {
+  const __m256i quote = _mm256_set1_epi8('"'), backslash = _mm256_set1_epi8('\\'), bit5 = _mm256_set1_epi8(0x20),
+                open = _mm256_set1_epi8('{'), close = _mm256_set1_epi8('}'), colon = _mm256_set1_epi8(':'),
+                comma = _mm256_set1_epi8(',');
+
+  block_masks res = {0, 0, 0};
+  for (int i = 0; i < 2; ++i) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+    __m256i folded = _mm256_or_si256(v, bit5);
+    __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+                                 _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+    res.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote))))
+                 << (32 * i);
+    res.backslash |=
+        static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash))))
+        << (32 * i);
+    res.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << (32 * i);
+  }
+
+  return res;
+}
+
+#endif
+
+/**
+ * Returns the mask of the characters that are escaped by a backslash, i.e.
+ * those that follow an odd-length run of backslashes. ``prev_escaped`` carries
+ * whether the first character of the next block is escaped.
+ */
+uint64_t find_escaped(uint64_t backslash, uint64_t &prev_escaped) {
+  const uint64_t even_bits = 0x5555555555555555ULL;
+
+  backslash &= ~prev_escaped;
+  uint64_t follows_escape = backslash << 1 | prev_escaped;
+  // Adding the start of every run that begins on an odd bit to the runs
+  // carries through them, which leaves the runs that begin on an even bit
+  uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+  uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+  prev_escaped = sequences_starting_on_even_bits < odd_sequence_starts ? 1 : 0;
+  uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+  return (even_bits ^ invert_mask) & follows_escape;
+}
+
+/**
+ * Sets every bit from each set bit up to, but not including, the next one.
+ */
+uint64_t prefix_xor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+int count_trailing_zeros(uint64_t x) {
+#ifdef __GNUC__
+  return __builtin_ctzll(x);
+#else
+  int res = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++res;
+  }
+  return res;
+#endif
+}
+
+template <block_masks (*Classify)(const char *)>
+bool find_structurals(const char *begin, const char *end, vector<uint32_t> &res) {
+  uint64_t prev_escaped = 0, prev_in_string = 0;
+  char tail[64];
+
+  for (const char *block = begin; block < end; block += 64) {
+    block_masks masks;
+    if (end - block >= 64) {
+      masks = Classify(block);
+    } else {
+      // The last partial block is padded with spaces
+      memset(tail, ' ', sizeof(tail));
+      memcpy(tail, block, end - block);
+      masks = Classify(tail);
+    }
+
+    uint64_t quote = masks.quote & ~find_escaped(masks.backslash, prev_escaped);
+    // Inside strings, including the opening quote but not the closing one
+    uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+    prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+    uint64_t structurals = (masks.op & ~in_string) | quote;
+    uint32_t offset = static_cast<uint32_t>(block - begin);
+    while (structurals != 0) {
+      res.push_back(offset + count_trailing_zeros(structurals));
+      structurals &= structurals - 1;
+    }
+  }
+
+  // An unclosed string
+  return prev_in_string == 0;
+}
+
+} // anonymous namespace
+
+bool json::structural_index::build(const char *begin, const char *end) {
+  m_begin = begin;
+  m_positions.clear();
+  if (static_cast<size_t>(end - begin) > max_size) {
+    return false;
+  }
+
+  // Structural characters are typically at least a few bytes apart
+  m_positions.reserve((end - begin) / 4 + 16);
+
+  bool closed;
+#ifdef DYND_SIMD_DISPATCH
+  switch (get_simd_isa()) {
+  case simd_avx512:
+  case simd_avx2:
+    closed = find_structurals<classify_avx2>(begin, end, m_positions);
+    break;
+  case simd_sse2:
+    closed = find_structurals<classify_sse2>(begin, end, m_positions);
+    break;
+  default:
+    closed = find_structurals<classify_scalar>(begin, end, m_positions);
+    break;
+  }
+#else
+  closed = find_structurals<classify_scalar>(begin, end, m_positions);
+#endif
+
+  return closed && build_structure();
+}
+
+bool json::structural_index::build_structure() {
+  size_t size = m_positions.size();
+  m_matches.resize(size);
+  m_counts.resize(size);
+
+  // The open brackets and braces, and the number of commas seen in each
+  vector<pair<size_t, size_t>> stack;
+  for (size_t i = 0; i < size; ++i) {
+    char c = m_begin[m_positions[i]];
+    switch (c) {
+    case '"':
+      // The closing quote is the next entry
+      ++i;
+      break;
+    case '[':
+    case '{':
+      stack.emplace_back(i, 0);
+      break;
+    case ']':
+    case '}': {
+      if (stack.empty() || m_begin[m_positions[stack.back().first]] != (c == ']' ? '[' : '{')) {
+        return false;
+      }
+
+      size_t open = stack.back().first;
+      size_t count = stack.back().second;
+      // Scalars are not in the index, so a bracket directly followed by its
+      // match may still hold one item
+      if (i > open + 1) {
+        ++count;
+      } else {
+        const char *item = m_begin + m_positions[open] + 1, *close = m_begin + m_positions[i];
+        skip_whitespace(item, close);
+        if (item != close) {
+          ++count;
+        }
+      }
+
+      m_matches[open] = static_cast<uint32_t>(i);
+      m_counts[open] = static_cast<uint32_t>(count);
+      stack.pop_back();
+      break;
+    }
+    case ',':
+      if (!stack.empty()) {
+        ++stack.back().second;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  return stack.empty();
+}
@@ -3,9 +3,15 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
 #include <dynd/callable.hpp>
+#include <dynd/json_index.hpp>
 #include <dynd/json_parser.hpp>
 #include <dynd/kernels/parse_kernel.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/parse.hpp>
 #include <dynd/types/base_bytes_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -13,6 +19,12 @@
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 using namespace std;
 using namespace dynd;
 
@@ -602,6 +614,358 @@ static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
   throw runtime_error(ss.str());
 }
 
+namespace {
+
+/**
+ * The second pass of the indexed JSON parser, which fills an array from the
+ * structural index of the text. It steps from one index entry to the next,
+ * only looking at the text in between to skip whitespace and to parse
+ * scalars, which it hands to the same functions as the character by
+ * character parser.
+ *
+ * Anything unexpected makes it return false instead of throwing, and the
+ * caller then parses the text again character by character, which reports
+ * the error exactly as before.
+ */
+class indexed_json_parser {
+  const json::structural_index &m_index;
+  const char *m_end;
+  const eval::eval_context *m_ectx;
+  // The next index entry, and the text position after what has been parsed
+  size_t m_next;
+  const char *m_pos;
+
+  // The position of the next index entry, or the end of the text
+  const char *next_position() const { return m_next < m_index.size() ? m_index.get(m_next) : m_end; }
+
+  // Skips whitespace up to the next index entry, and returns its character if
+  // it is reached, or 0 if there is a scalar in front of it
+  char peek() {
+    const char *next = next_position();
+    skip_whitespace(m_pos, next);
+    return m_pos == next && next != m_end ? *next : 0;
+  }
+
+  bool consume(char c) {
+    if (peek() != c) {
+      return false;
+    }
+
+    ++m_pos;
+    ++m_next;
+    return true;
+  }
+
+  // The string that starts at the next index entry, without its quotes
+  void get_string(const char *&begin, const char *&end) const {
+    begin = m_index.get(m_next) + 1;
+    end = m_index.get(m_next + 1);
+  }
+
+  void consume_string() {
+    m_pos = m_index.get(m_next + 1) + 1;
+    m_next += 2;
+  }
+
+  bool parse_scalar(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    const char *value_end;
+    size_t next_after;
+    char c = peek();
+    if (c == 0) {
+      value_end = next_position();
+      next_after = m_next;
+    } else if (c == '"') {
+      value_end = m_index.get(m_next + 1) + 1;
+      next_after = m_next + 2;
+    } else {
+      return false;
+    }
+
+    const char *begin = m_pos;
+    ::parse_json(tp, arrmeta, out_data, begin, value_end, m_ectx);
+    skip_whitespace(begin, value_end);
+    if (begin != value_end) {
+      return false;
+    }
+
+    m_pos = value_end;
+    m_next = next_after;
+    return true;
+  }
+
+  bool parse_string(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    if (peek() != '"') {
+      return parse_scalar(tp, arrmeta, out_data);
+    }
+
+    const char *strbegin, *strend;
+    get_string(strbegin, strend);
+    if (memchr(strbegin, '\\', strend - strbegin) != NULL) {
+      return parse_scalar(tp, arrmeta, out_data);
+    }
+
+    tp.extended<ndt::base_string_type>()->set_from_utf8_string(arrmeta, out_data, strbegin, strend, m_ectx);
+    consume_string();
+    return true;
+  }
+
+  bool parse_strided_dim(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    intptr_t dim_size, stride;
+    ndt::type el_tp;
+    const char *el_arrmeta;
+    if (!tp.get_as_strided(arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
+      return false;
+    }
+
+    size_t open = m_next;
+    if (!consume('[') || m_index.get_count(open) != static_cast<size_t>(dim_size)) {
+      return false;
+    }
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      if (!parse(el_tp, el_arrmeta, out_data + i * stride) || (i < dim_size - 1 && !consume(','))) {
+        return false;
+      }
+    }
+
+    return consume(']');
+  }
+
+  bool parse_var_dim(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+    const char *el_arrmeta = arrmeta + sizeof(ndt::var_dim_type::metadata_type);
+
+    size_t open = m_next;
+    if (!consume('[')) {
+      return false;
+    }
+
+    // The index knows the size up front, so the elements are allocated once
+    intptr_t size = m_index.get_count(open);
+    ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(out_data);
+    out->begin = md->blockref->alloc(size);
+    out->size = size;
+    for (intptr_t i = 0; i < size; ++i) {
+      if (!parse(el_tp, el_arrmeta, out->begin + i * md->stride) || (i < size - 1 && !consume(','))) {
+        return false;
+      }
+    }
+
+    return consume(']');
+  }
+
+  static bool is_name(const char *begin, const char *end, const std::string &name) {
+    return static_cast<size_t>(end - begin) == name.size() && memcmp(begin, name.data(), name.size()) == 0;
+  }
+
+  bool parse_struct_from_object(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    const ndt::struct_type *fsd = tp.extended<ndt::struct_type>();
+    intptr_t field_count = fsd->get_field_count();
+    const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const std::vector<uintptr_t> &arrmeta_offsets = fsd->get_arrmeta_offsets();
+
+    shortvector<bool> populated_fields(field_count);
+    memset(populated_fields.get(), 0, sizeof(bool) * field_count);
+
+    size_t open = m_next;
+    if (!consume('{')) {
+      return false;
+    }
+    // Fields usually come in the order of the type, so that one is tried
+    // first before searching all of them
+    intptr_t expected = 0;
+    for (size_t j = 0, j_end = m_index.get_count(open); j < j_end; ++j) {
+      if (peek() != '"') {
+        return false;
+      }
+      const char *strbegin, *strend;
+      get_string(strbegin, strend);
+      intptr_t i = -1;
+      if (memchr(strbegin, '\\', strend - strbegin) != NULL) {
+        const char *begin = m_pos, *nbegin, *nend;
+        bool escaped;
+        parse_doublequote_string_no_ws(begin, m_end, nbegin, nend, escaped);
+        std::string name;
+        unescape_string(nbegin, nend, name);
+        i = fsd->get_field_index(name);
+      } else if (expected < field_count && is_name(strbegin, strend, fsd->get_field_name(expected))) {
+        i = expected;
+      } else {
+        for (intptr_t k = 0; k < field_count; ++k) {
+          if (is_name(strbegin, strend, fsd->get_field_name(k))) {
+            i = k;
+            break;
+          }
+        }
+      }
+      consume_string();
+      if (!consume(':')) {
+        return false;
+      }
+
+      if (i == -1) {
+        if (!skip()) {
+          return false;
+        }
+      } else {
+        if (!parse(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i])) {
+          return false;
+        }
+        populated_fields[i] = true;
+        expected = i + 1;
+      }
+      if (j < j_end - 1 && !consume(',')) {
+        return false;
+      }
+    }
+    if (!consume('}')) {
+      return false;
+    }
+
+    for (intptr_t i = 0; i < field_count; ++i) {
+      if (!populated_fields[i]) {
+        const ndt::type &field_tp = fsd->get_field_type(i);
+        if (field_tp.get_id() != option_id) {
+          return false;
+        }
+        nd::old_assign_na(field_tp, arrmeta + arrmeta_offsets[i], out_data + data_offsets[i]);
+      }
+    }
+
+    return true;
+  }
+
+  template <class Type>
+  bool parse_tuple_from_list(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    auto fsd = tp.extended<Type>();
+    intptr_t field_count = fsd->get_field_count();
+    const uintptr_t *data_offsets = reinterpret_cast<const uintptr_t *>(arrmeta);
+    const std::vector<uintptr_t> &arrmeta_offsets = fsd->get_arrmeta_offsets();
+
+    size_t open = m_next;
+    if (!consume('[') || m_index.get_count(open) != static_cast<size_t>(field_count)) {
+      return false;
+    }
+    for (intptr_t i = 0; i < field_count; ++i) {
+      if (!parse(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i]) ||
+          (i < field_count - 1 && !consume(','))) {
+        return false;
+      }
+    }
+
+    return consume(']');
+  }
+
+  // Skips a value, checking it like ``skip_json_value`` does
+  bool skip() {
+    switch (peek()) {
+    case 0: {
+      const char *begin = m_pos, *end = next_position(), *nbegin, *nend;
+      if (!parse_token(begin, end, "true") && !parse_token(begin, end, "false") && !parse_token(begin, end, "null") &&
+          !json::parse_number(begin, end, nbegin, nend)) {
+        return false;
+      }
+      skip_whitespace(begin, end);
+      m_pos = end;
+      return begin == end;
+    }
+    case '"': {
+      const char *strbegin, *strend;
+      get_string(strbegin, strend);
+      if (memchr(strbegin, '\\', strend - strbegin) != NULL) {
+        const char *begin = m_pos, *nbegin, *nend;
+        bool escaped;
+        parse_doublequote_string_no_ws(begin, m_end, nbegin, nend, escaped);
+      }
+      consume_string();
+      return true;
+    }
+    case '[': {
+      size_t count = m_index.get_count(m_next);
+      consume('[');
+      for (size_t i = 0; i < count; ++i) {
+        if (!skip() || (i < count - 1 && !consume(','))) {
+          return false;
+        }
+      }
+      return consume(']');
+    }
+    case '{': {
+      size_t count = m_index.get_count(m_next);
+      consume('{');
+      for (size_t i = 0; i < count; ++i) {
+        if (peek() != '"') {
+          return false;
+        }
+        if (!skip() || !consume(':') || !skip() || (i < count - 1 && !consume(','))) {
+          return false;
+        }
+      }
+      return consume('}');
+    }
+    default:
+      return false;
+    }
+  }
+
+public:
+  indexed_json_parser(const json::structural_index &index, const char *begin, const char *end,
+                      const eval::eval_context *ectx)
+      : m_index(index), m_end(end), m_ectx(ectx), m_next(0), m_pos(begin) {}
+
+  bool parse(const ndt::type &tp, const char *arrmeta, char *out_data) {
+    switch (tp.get_id()) {
+    case fixed_dim_id:
+      return parse_strided_dim(tp, arrmeta, out_data);
+    case var_dim_id:
+      return parse_var_dim(tp, arrmeta, out_data);
+    case struct_id:
+      if (peek() == '[') {
+        return parse_tuple_from_list<ndt::struct_type>(tp, arrmeta, out_data);
+      }
+      return parse_struct_from_object(tp, arrmeta, out_data);
+    case tuple_id:
+      return parse_tuple_from_list<ndt::tuple_type>(tp, arrmeta, out_data);
+    case string_id:
+      return parse_string(tp, arrmeta, out_data);
+    default:
+      return parse_scalar(tp, arrmeta, out_data);
+    }
+  }
+
+  /**
+   * Returns true if only whitespace is left after the parsed value.
+   */
+  bool at_end() {
+    skip_whitespace(m_pos, m_end);
+    return m_pos == m_end;
+  }
+};
+
+// Building an index does not pay off for short texts
+const size_t indexed_json_min_size = 256;
+
+} // anonymous namespace
+
+bool dynd::parse_indexed_json(nd::array &out, const char *json_begin, const char *json_end,
+                              const eval::eval_context *ectx) {
+  if (get_simd_isa() == simd_none || static_cast<size_t>(json_end - json_begin) < indexed_json_min_size) {
+    return false;
+  }
+
+  json::structural_index index;
+  if (!index.build(json_begin, json_end)) {
+    return false;
+  }
+
+  try {
+    indexed_json_parser parser(index, json_begin, json_end, ectx);
+    return parser.parse(out.get_type(), out.get()->metadata(), out.data()) && parser.at_end();
+  } catch (...) {
+    return false;
+  }
+}
+
 /**
  * Returns the row/column where the error occured, as well as the current and
  * previous
@@ -666,6 +1030,25 @@ void print_json_parse_error_marker(std::ostream &o, const std::string &line_prev
   }
 }
 
+/**
+ * Formats the message of an error from parsing the JSON in [json_begin,
+ * json_end), which starts after ``line_offset`` lines of the input.
+ */
+static std::string json_parse_error_message(const char *json_begin, const char *json_end, const parse_error &e,
+                                            int line_offset) {
+  stringstream ss;
+  std::string line_prev, line_cur;
+  int line, column;
+  get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
+  ss << "Error parsing JSON at line " << line + line_offset << ", column " << column << "\n";
+  if (const json_parse_error *je = dynamic_cast<const json_parse_error *>(&e)) {
+    ss << "DyND Type: " << je->get_type() << "\n";
+  }
+  ss << "Message: " << e.what() << "\n";
+  print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
+  return ss.str();
+}
+
 void dynd::validate_json(const char *json_begin, const char *json_end) {
   try {
     const char *begin = json_begin, *end = json_end;
@@ -687,6 +1070,10 @@ void dynd::validate_json(const char *json_begin, const char *json_end) {
 }
 
 void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx) {
+  if (parse_indexed_json(out, json_begin, json_end, ectx)) {
+    return;
+  }
+
   try {
     const char *begin = json_begin, *end = json_end;
     ndt::type tp = out.get_type();
@@ -695,25 +1082,8 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
     if (begin != end) {
       throw json_parse_error(begin, "unexpected trailing JSON text", tp);
     }
-  } catch (const json_parse_error &e) {
-    stringstream ss;
-    std::string line_prev, line_cur;
-    int line, column;
-    get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
-    ss << "DyND Type: " << e.get_type() << "\n";
-    ss << "Message: " << e.what() << "\n";
-    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-    throw invalid_argument(ss.str());
   } catch (const parse_error &e) {
-    stringstream ss;
-    std::string line_prev, line_cur;
-    int line, column;
-    get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
-    ss << "Message: " << e.what() << "\n";
-    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-    throw invalid_argument(ss.str());
+    throw invalid_argument(json_parse_error_message(json_begin, json_end, e, 0));
   }
 }
 
@@ -728,6 +1098,213 @@ nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const ch
   return result;
 }
 
+namespace {
+
+/**
+ * Reads the lines of newline-delimited JSON from a source in chunks, keeping
+ * only the chunk that holds the current line in memory.
+ */
+class json_lines_reader {
+  std::function<size_t(char *, size_t)> m_read;
+  std::vector<char> m_buffer;
+  // The part of the buffer that has been read but not returned yet
+  size_t m_begin, m_end;
+  bool m_eof;
+  int m_line;
+
+  // Reads the next chunk after what is left in the buffer, returning false at
+  // the end of the input
+  bool fill() {
+    memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+    // A line longer than the buffer makes it grow
+    if (m_end == m_buffer.size()) {
+      m_buffer.resize(2 * m_buffer.size());
+    }
+
+    size_t count = m_read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+    m_end += count;
+    m_eof = count == 0;
+    return !m_eof;
+  }
+
+public:
+  json_lines_reader(const std::function<size_t(char *, size_t)> &read, size_t chunk_size)
+      : m_read(read), m_buffer(std::max<size_t>(chunk_size, 1)), m_begin(0), m_end(0), m_eof(false), m_line(0) {}
+
+  /**
+   * Finds the next line that is not blank, returning false at the end of
+   * the input.
+   */
+  bool next(const char *&begin, const char *&end) {
+    for (;;) {
+      const char *data = m_buffer.data();
+      const char *newline = reinterpret_cast<const char *>(memchr(data + m_begin, '\n', m_end - m_begin));
+      if (newline != NULL) {
+        begin = data + m_begin;
+        end = newline;
+        m_begin = newline + 1 - data;
+      } else if (!m_eof && fill()) {
+        continue;
+      } else if (m_begin != m_end) {
+        // The last line has no newline. A failed fill may still have grown
+        // the buffer, so ``data`` can point at the old one
+        data = m_buffer.data();
+        begin = data + m_begin;
+        end = data + m_end;
+        m_begin = m_end;
+      } else {
+        return false;
+      }
+
+      ++m_line;
+      const char *pos = begin;
+      skip_whitespace(pos, end);
+      if (pos != end) {
+        return true;
+      }
+    }
+  }
+
+  /**
+   * The number of the line that ``next`` returned last, starting at one.
+   */
+  int get_line() const { return m_line; }
+};
+
+std::function<size_t(char *, size_t)> make_stream_read(std::istream &in) {
+  return [&in](char *data, size_t size) {
+    in.read(data, size);
+    if (in.bad()) {
+      throw runtime_error("parse_json_lines: error reading from the stream");
+    }
+    return static_cast<size_t>(in.gcount());
+  };
+}
+
+std::function<size_t(char *, size_t)> make_fd_read(int fd) {
+  return [fd](char *data, size_t size) {
+    for (;;) {
+#ifdef _WIN32
+      int count = _read(fd, data, static_cast<unsigned int>(std::min<size_t>(size, INT_MAX)));
+#else
+      ssize_t count = read(fd, data, size);
+#endif
+      if (count >= 0) {
+        return static_cast<size_t>(count);
+      }
+      if (errno != EINTR) {
+        stringstream ss;
+        ss << "parse_json_lines: error reading from file descriptor " << fd << ": " << strerror(errno);
+        throw runtime_error(ss.str());
+      }
+    }
+  };
+}
+
+void parse_json_line(const ndt::type &tp, const char *arrmeta, char *out_data, const char *line_begin,
+                     const char *line_end, int line, const eval::eval_context *ectx) {
+  try {
+    const char *begin = line_begin;
+    ::parse_json(tp, arrmeta, out_data, begin, line_end, ectx);
+    skip_whitespace(begin, line_end);
+    if (begin != line_end) {
+      throw json_parse_error(begin, "unexpected trailing JSON text", tp);
+    }
+  } catch (const parse_error &e) {
+    throw invalid_argument(json_parse_error_message(line_begin, line_end, e, line - 1));
+  }
+}
+
+nd::array parse_json_lines(const ndt::type &record_tp, json_lines_reader &reader, const eval::eval_context *ectx) {
+  ndt::type tp = ndt::make_type<ndt::var_dim_type>(record_tp);
+  nd::array res = nd::empty(tp);
+  const ndt::var_dim_type::metadata_type *md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(res.get()->metadata());
+  const char *el_arrmeta = res.get()->metadata() + sizeof(ndt::var_dim_type::metadata_type);
+  ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(res.data());
+
+  intptr_t size = 0, allocated_size = 8;
+  out->begin = md->blockref->alloc(allocated_size);
+  out->size = 0;
+
+  const char *begin, *end;
+  while (reader.next(begin, end)) {
+    if (size == allocated_size) {
+      allocated_size *= 2;
+      out->begin = md->blockref->resize(out->begin, allocated_size);
+    }
+    parse_json_line(record_tp, el_arrmeta, out->begin + size * md->stride, begin, end, reader.get_line(), ectx);
+    out->size = ++size;
+  }
+
+  // Shrink-wrap the memory to just fit the records
+  out->begin = md->blockref->resize(out->begin, size);
+  tp.extended()->arrmeta_finalize_buffers(res.get()->metadata());
+
+  return res;
+}
+
+void parse_json_lines(const ndt::type &record_tp, json_lines_reader &reader, size_t batch_size,
+                      const std::function<void(const nd::array &)> &callback, const eval::eval_context *ectx) {
+  if (batch_size == 0) {
+    throw invalid_argument("parse_json_lines: the batch size must be positive");
+  }
+
+  nd::array batch;
+  intptr_t size = 0, stride = 0;
+  const char *begin, *end;
+  while (reader.next(begin, end)) {
+    if (size == 0) {
+      batch = nd::empty(batch_size, record_tp);
+      stride = reinterpret_cast<const size_stride_t *>(batch.get()->metadata())->stride;
+    }
+    parse_json_line(record_tp, batch.get()->metadata() + sizeof(size_stride_t), batch.data() + size * stride, begin,
+                    end, reader.get_line(), ectx);
+
+    if (++size == static_cast<intptr_t>(batch_size)) {
+      batch.get_type().extended()->arrmeta_finalize_buffers(batch.get()->metadata());
+      callback(batch);
+      batch = nd::array();
+      size = 0;
+    }
+  }
+
+  if (size != 0) {
+    batch.get_type().extended()->arrmeta_finalize_buffers(batch.get()->metadata());
+    callback(batch(irange() < size));
+  }
+}
+
+} // anonymous namespace
+
+nd::array dynd::parse_json_lines(const ndt::type &record_tp, std::istream &in, const eval::eval_context *ectx,
+                                 size_t chunk_size) {
+  json_lines_reader reader(make_stream_read(in), chunk_size);
+  return ::parse_json_lines(record_tp, reader, ectx);
+}
+
+nd::array dynd::parse_json_lines(const ndt::type &record_tp, int fd, const eval::eval_context *ectx,
+                                 size_t chunk_size) {
+  json_lines_reader reader(make_fd_read(fd), chunk_size);
+  return ::parse_json_lines(record_tp, reader, ectx);
+}
+
+void dynd::parse_json_lines(const ndt::type &record_tp, std::istream &in, size_t batch_size,
+                            const std::function<void(const nd::array &)> &callback, const eval::eval_context *ectx,
+                            size_t chunk_size) {
+  json_lines_reader reader(make_stream_read(in), chunk_size);
+  ::parse_json_lines(record_tp, reader, batch_size, callback, ectx);
+}
+
+void dynd::parse_json_lines(const ndt::type &record_tp, int fd, size_t batch_size,
+                            const std::function<void(const nd::array &)> &callback, const eval::eval_context *ectx,
+                            size_t chunk_size) {
+  json_lines_reader reader(make_fd_read(fd), chunk_size);
+  ::parse_json_lines(record_tp, reader, batch_size, callback, ectx);
+}
+
 /*
 static ndt::type discover_type(const char *&begin, const char *end)
 {
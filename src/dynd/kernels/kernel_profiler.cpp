@@ -0,0 +1,169 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+#include <dynd/kernels/kernel_profiler.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+atomic<bool> &profiling_enabled() {
+  static atomic<bool> enabled(false);
+  return enabled;
+}
+
+nd::detail::kernel_profile_node &root_node() {
+  static nd::detail::kernel_profile_node root(nullptr);
+  return root;
+}
+
+// Serializes the insertion of nodes, so that no type appears twice below the
+// same parent. Readers walk the children without it.
+mutex &insert_mutex() {
+  static mutex m;
+  return m;
+}
+
+thread_local nd::detail::kernel_profile_node *current_node = nullptr;
+
+nd::detail::kernel_profile_node *find_child(nd::detail::kernel_profile_node *parent, const type_info &type) {
+  for (nd::detail::kernel_profile_node *child = parent->first_child.load(memory_order_acquire); child != nullptr;
+       child = child->next_sibling) {
+    if (*child->type == type) {
+      return child;
+    }
+  }
+
+  return nullptr;
+}
+
+string demangle(const type_info &type) {
+#ifdef __GNUC__
+  int status = 0;
+  unique_ptr<char, void (*)(void *)> name(abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), free);
+  if (status == 0 && name != nullptr) {
+    return name.get();
+  }
+#endif
+
+  return type.name();
+}
+
+bool by_nanoseconds(const nd::kernel_profile_entry &lhs, const nd::kernel_profile_entry &rhs) {
+  return lhs.nanoseconds > rhs.nanoseconds;
+}
+
+// Nodes that have not been called since the last reset are left out
+void make_entry(const nd::detail::kernel_profile_node *node, nd::kernel_profile_entry &entry) {
+  for (const nd::detail::kernel_profile_node *child = node->first_child.load(memory_order_acquire); child != nullptr;
+       child = child->next_sibling) {
+    uint64_t calls = child->calls.load(memory_order_relaxed);
+    if (calls != 0) {
+      entry.children.emplace_back(demangle(*child->type));
+      nd::kernel_profile_entry &child_entry = entry.children.back();
+      child_entry.calls = calls;
+      child_entry.elements = child->elements.load(memory_order_relaxed);
+      child_entry.nanoseconds = child->nanoseconds.load(memory_order_relaxed);
+      make_entry(child, child_entry);
+    }
+  }
+
+  sort(entry.children.begin(), entry.children.end(), by_nanoseconds);
+}
+
+void sum_by_type(const nd::kernel_profile_entry &entry, map<string, nd::kernel_profile_entry> &res) {
+  for (const nd::kernel_profile_entry &child : entry.children) {
+    nd::kernel_profile_entry &sum = res.emplace(child.name, nd::kernel_profile_entry(child.name)).first->second;
+    sum.calls += child.calls;
+    sum.elements += child.elements;
+    // Summing the time excluding children avoids counting a kernel that
+    // calls itself through its children more than once
+    sum.nanoseconds += child.self_nanoseconds();
+    sum_by_type(child, res);
+  }
+}
+
+void reset(nd::detail::kernel_profile_node *node) {
+  for (nd::detail::kernel_profile_node *child = node->first_child.load(memory_order_acquire); child != nullptr;
+       child = child->next_sibling) {
+    child->calls.store(0, memory_order_relaxed);
+    child->elements.store(0, memory_order_relaxed);
+    child->nanoseconds.store(0, memory_order_relaxed);
+    reset(child);
+  }
+}
+
+void print(ostream &o, const nd::kernel_profile_entry &entry, const string &indent) {
+  for (const nd::kernel_profile_entry &child : entry.children) {
+    o << indent << child.name << ": " << child.calls << " calls, " << child.elements << " elements, "
+      << child.nanoseconds / 1000 << " us (" << child.self_nanoseconds() / 1000 << " us self)\n";
+    print(o, child, indent + "  ");
+  }
+}
+
+} // anonymous namespace
+
+bool dynd::kernel_profiling_enabled() { return profiling_enabled().load(memory_order_relaxed); }
+
+void dynd::set_kernel_profiling(bool enabled) { profiling_enabled().store(enabled, memory_order_relaxed); }
+
+nd::detail::kernel_profile_node *nd::detail::enter_kernel_profile(const type_info &type, kernel_profile_node *&parent) {
+  parent = current_node;
+  kernel_profile_node *node = parent == nullptr ? &root_node() : parent;
+
+  kernel_profile_node *child = find_child(node, type);
+  if (child == nullptr) {
+    lock_guard<mutex> lock(insert_mutex());
+    child = find_child(node, type);
+    if (child == nullptr) {
+      child = new kernel_profile_node(&type);
+      child->next_sibling = node->first_child.load(memory_order_relaxed);
+      node->first_child.store(child, memory_order_release);
+    }
+  }
+
+  current_node = child;
+  return child;
+}
+
+void nd::detail::exit_kernel_profile(kernel_profile_node *parent) { current_node = parent; }
+
+nd::kernel_profile_entry nd::get_kernel_profile() {
+  kernel_profile_entry res;
+  make_entry(&root_node(), res);
+  for (const kernel_profile_entry &child : res.children) {
+    res.calls += child.calls;
+    res.elements += child.elements;
+    res.nanoseconds += child.nanoseconds;
+  }
+
+  return res;
+}
+
+vector<nd::kernel_profile_entry> nd::get_kernel_profile_by_type() {
+  map<string, kernel_profile_entry> sums;
+  sum_by_type(get_kernel_profile(), sums);
+
+  vector<kernel_profile_entry> res;
+  for (auto &sum : sums) {
+    res.push_back(sum.second);
+  }
+  sort(res.begin(), res.end(), by_nanoseconds);
+
+  return res;
+}
+
+void nd::reset_kernel_profile() { reset(&root_node()); }
+
+void nd::print_kernel_profile(ostream &o) { print(o, get_kernel_profile(), ""); }
@@ -0,0 +1,47 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <atomic>
+
+#include <dynd/kernels/simd.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+simd_isa detect() {
+#ifdef DYND_SIMD_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq")) {
+    return simd_avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_avx2;
+  }
+#endif
+
+  return simd_sse2;
+}
+
+atomic<int> &current_isa() {
+  static atomic<int> isa(detected_simd_isa());
+  return isa;
+}
+
+} // anonymous namespace
+
+simd_isa dynd::detected_simd_isa() {
+  static const simd_isa isa = detect();
+  return isa;
+}
+
+simd_isa dynd::get_simd_isa() { return static_cast<simd_isa>(current_isa().load(memory_order_relaxed)); }
+
+void dynd::set_simd_isa(simd_isa isa) {
+  current_isa().store(min(isa, detected_simd_isa()), memory_order_relaxed);
+}
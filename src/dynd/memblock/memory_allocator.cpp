@@ -0,0 +1,265 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <dynd/memblock/memory_allocator.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const size_t pool_class_count = 13;
+
+// Upper bound on the bytes of each size class kept by one thread's cache
+const size_t pool_class_cache_bytes = 1 << 21;
+
+// Upper bound on the number of chunks of each size class in that cache
+const size_t pool_class_cache_count = 64;
+
+size_t pool_class_index(size_t size) {
+  size_t index = 0;
+  for (size_t class_size = nd::pool_memory_allocator::min_class_size; class_size < size; class_size <<= 1) {
+    ++index;
+  }
+
+  return index;
+}
+
+size_t pool_class_size(size_t index) { return nd::pool_memory_allocator::min_class_size << index; }
+
+/**
+ * The freed chunks of one thread, in a singly linked list per size class
+ * that is threaded through the chunks themselves.
+ */
+struct pool_cache {
+  char *m_head[pool_class_count];
+  size_t m_count[pool_class_count];
+
+  pool_cache() {
+    fill(m_head, m_head + pool_class_count, nullptr);
+    fill(m_count, m_count + pool_class_count, 0);
+  }
+
+  ~pool_cache();
+
+  char *pop(size_t index) {
+    char *ptr = m_head[index];
+    if (ptr != nullptr) {
+      m_head[index] = *reinterpret_cast<char **>(ptr);
+      --m_count[index];
+    }
+
+    return ptr;
+  }
+
+  bool push(size_t index, char *ptr) {
+    size_t max_count = min(pool_class_cache_count, max<size_t>(2, pool_class_cache_bytes / pool_class_size(index)));
+    if (m_count[index] >= max_count) {
+      return false;
+    }
+
+    *reinterpret_cast<char **>(ptr) = m_head[index];
+    m_head[index] = ptr;
+    ++m_count[index];
+    return true;
+  }
+};
+
+// Chunks can be freed by other thread-local or static destructors after the
+// cache of a thread is gone, in which case they go straight back to free
+thread_local bool pool_cache_destroyed = false;
+
+pool_cache::~pool_cache() {
+  pool_cache_destroyed = true;
+  for (size_t index = 0; index < pool_class_count; ++index) {
+    while (char *ptr = pop(index)) {
+      free(ptr);
+    }
+  }
+}
+
+pool_cache *get_pool_cache() {
+  if (pool_cache_destroyed) {
+    return nullptr;
+  }
+
+  thread_local pool_cache cache;
+  return &cache;
+}
+
+char *checked_malloc(size_t size) {
+  char *ptr = reinterpret_cast<char *>(malloc(size));
+  if (ptr == nullptr && size != 0) {
+    throw bad_alloc();
+  }
+
+  return ptr;
+}
+
+char *checked_realloc(char *ptr, size_t new_size) {
+  char *new_ptr = reinterpret_cast<char *>(realloc(ptr, new_size));
+  if (new_ptr == nullptr && new_size != 0) {
+    throw bad_alloc();
+  }
+
+  return new_ptr;
+}
+
+size_t arena_aligned_size(size_t size) { return (size + 15) & ~static_cast<size_t>(15); }
+
+shared_ptr<nd::base_memory_allocator> &default_memory_allocator() {
+  static shared_ptr<nd::base_memory_allocator> allocator = nd::malloc_allocator();
+  return allocator;
+}
+
+} // anonymous namespace
+
+nd::base_memory_allocator::~base_memory_allocator() {}
+
+char *nd::base_memory_allocator::reallocate(char *ptr, size_t size, size_t new_size, size_t used_size) {
+  char *new_ptr = allocate(new_size);
+  memcpy(new_ptr, ptr, min(used_size, new_size));
+  deallocate(ptr, size);
+  return new_ptr;
+}
+
+char *nd::malloc_memory_allocator::allocate(size_t size) { return checked_malloc(size); }
+
+void nd::malloc_memory_allocator::deallocate(char *ptr, size_t DYND_UNUSED(size)) { free(ptr); }
+
+char *nd::malloc_memory_allocator::reallocate(char *ptr, size_t DYND_UNUSED(size), size_t new_size,
+                                              size_t DYND_UNUSED(used_size)) {
+  return checked_realloc(ptr, new_size);
+}
+
+char *nd::pool_memory_allocator::allocate(size_t size) {
+  if (size > max_class_size) {
+    return checked_malloc(size);
+  }
+
+  size_t index = pool_class_index(size);
+  pool_cache *cache = get_pool_cache();
+  if (cache != nullptr) {
+    char *ptr = cache->pop(index);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+  }
+
+  return checked_malloc(pool_class_size(index));
+}
+
+void nd::pool_memory_allocator::deallocate(char *ptr, size_t size) {
+  if (size <= max_class_size) {
+    pool_cache *cache = get_pool_cache();
+    if (cache != nullptr && cache->push(pool_class_index(size), ptr)) {
+      return;
+    }
+  }
+
+  free(ptr);
+}
+
+char *nd::pool_memory_allocator::reallocate(char *ptr, size_t size, size_t new_size, size_t used_size) {
+  if (size > max_class_size && new_size > max_class_size) {
+    return checked_realloc(ptr, new_size);
+  }
+
+  // The chunk already has the capacity of its whole size class
+  if (size <= max_class_size && new_size <= max_class_size && pool_class_index(size) == pool_class_index(new_size)) {
+    return ptr;
+  }
+
+  return base_memory_allocator::reallocate(ptr, size, new_size, used_size);
+}
+
+nd::arena_memory_allocator::arena_memory_allocator(size_t slab_size)
+    : m_slab_size(slab_size), m_current(nullptr), m_end(nullptr), m_reserved_size(0) {}
+
+nd::arena_memory_allocator::~arena_memory_allocator() { release(); }
+
+char *nd::arena_memory_allocator::allocate(size_t size) {
+  size = arena_aligned_size(size);
+
+  lock_guard<mutex> lock(m_mutex);
+  // Large requests get a slab of their own, so they do not waste the rest of
+  // the current one
+  if (size > m_slab_size / 4) {
+    m_slabs.push_back(nullptr);
+    m_slabs.back() = checked_malloc(size);
+    m_reserved_size += size;
+    return m_slabs.back();
+  }
+
+  if (static_cast<size_t>(m_end - m_current) < size) {
+    m_slabs.push_back(nullptr);
+    m_slabs.back() = checked_malloc(m_slab_size);
+    m_reserved_size += m_slab_size;
+    m_current = m_slabs.back();
+    m_end = m_current + m_slab_size;
+  }
+
+  char *ptr = m_current;
+  m_current += size;
+  return ptr;
+}
+
+void nd::arena_memory_allocator::deallocate(char *DYND_UNUSED(ptr), size_t DYND_UNUSED(size)) {}
+
+char *nd::arena_memory_allocator::reallocate(char *ptr, size_t size, size_t new_size, size_t used_size) {
+  {
+    lock_guard<mutex> lock(m_mutex);
+    // The most recent allocation can grow or shrink in place
+    if (ptr + arena_aligned_size(size) == m_current &&
+        static_cast<size_t>(m_end - ptr) >= arena_aligned_size(new_size)) {
+      m_current = ptr + arena_aligned_size(new_size);
+      return ptr;
+    }
+  }
+
+  return base_memory_allocator::reallocate(ptr, size, new_size, used_size);
+}
+
+size_t nd::arena_memory_allocator::get_reserved_size() {
+  lock_guard<mutex> lock(m_mutex);
+  return m_reserved_size;
+}
+
+void nd::arena_memory_allocator::release() {
+  lock_guard<mutex> lock(m_mutex);
+  for (char *slab : m_slabs) {
+    free(slab);
+  }
+  m_slabs.clear();
+  m_current = nullptr;
+  m_end = nullptr;
+  m_reserved_size = 0;
+}
+
+const shared_ptr<nd::base_memory_allocator> &nd::malloc_allocator() {
+  static shared_ptr<base_memory_allocator> allocator = make_shared<malloc_memory_allocator>();
+  return allocator;
+}
+
+const shared_ptr<nd::base_memory_allocator> &nd::pool_allocator() {
+  static shared_ptr<base_memory_allocator> allocator = make_shared<pool_memory_allocator>();
+  return allocator;
+}
+
+shared_ptr<nd::base_memory_allocator> nd::get_default_memory_allocator() {
+  return atomic_load(&default_memory_allocator());
+}
+
+void nd::set_default_memory_allocator(const shared_ptr<base_memory_allocator> &allocator) {
+  if (allocator == nullptr) {
+    throw invalid_argument("the default memory allocator cannot be null");
+  }
+
+  atomic_store(&default_memory_allocator(), allocator);
+}
@@ -0,0 +1,179 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dynd/parallel.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+thread_local bool in_worker = false;
+
+/**
+ * A process-wide pool of worker threads that runs one job at a time. The
+ * thread that submits a job takes part in it as worker 0, and workers
+ * 1, 2, ... are started lazily as larger jobs come in.
+ */
+class thread_pool {
+  mutex m_busy;
+  mutex m_mutex;
+  condition_variable m_start;
+  condition_variable m_done;
+  vector<thread> m_threads;
+  const function<void(size_t)> *m_job;
+  size_t m_nworkers;
+  size_t m_running;
+  size_t m_generation;
+  bool m_stop;
+
+  void work(size_t worker) {
+    in_worker = true;
+
+    size_t generation = 0;
+    unique_lock<mutex> lock(m_mutex);
+    for (;;) {
+      m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+
+      generation = m_generation;
+      if (worker >= m_nworkers) {
+        continue;
+      }
+
+      const function<void(size_t)> &job = *m_job;
+      lock.unlock();
+      job(worker);
+      lock.lock();
+
+      if (--m_running == 0) {
+        m_done.notify_one();
+      }
+    }
+  }
+
+public:
+  thread_pool() : m_job(NULL), m_nworkers(0), m_running(0), m_generation(0), m_stop(false) {}
+
+  ~thread_pool() {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_start.notify_all();
+
+    for (thread &t : m_threads) {
+      t.join();
+    }
+  }
+
+  /**
+   * Runs ``job(worker)`` for every worker in [0, nworkers), returning false
+   * without running anything if the pool is busy with another job. The job
+   * must not throw.
+   */
+  bool run(size_t nworkers, const function<void(size_t)> &job) {
+    unique_lock<mutex> busy(m_busy, try_to_lock);
+    if (!busy.owns_lock()) {
+      return false;
+    }
+
+    unique_lock<mutex> lock(m_mutex);
+    while (m_threads.size() + 1 < nworkers) {
+      m_threads.emplace_back(&thread_pool::work, this, m_threads.size() + 1);
+    }
+
+    m_job = &job;
+    m_nworkers = nworkers;
+    m_running = nworkers - 1;
+    ++m_generation;
+    lock.unlock();
+    m_start.notify_all();
+
+    in_worker = true;
+    job(0);
+    in_worker = false;
+
+    lock.lock();
+    m_done.wait(lock, [&] { return m_running == 0; });
+    m_job = NULL;
+
+    return true;
+  }
+};
+
+thread_pool &get_thread_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+} // anonymous namespace
+
+size_t dynd::hardware_concurrency() {
+  static const size_t n = max(thread::hardware_concurrency(), 1u);
+  return n;
+}
+
+bool dynd::in_parallel_region() { return in_worker; }
+
+void dynd::parallel_for(size_t count, size_t grain_size, size_t nthreads,
+                        const function<void(size_t, size_t, size_t)> &func) {
+  if (count == 0) {
+    return;
+  }
+
+  if (nthreads == 0) {
+    nthreads = hardware_concurrency();
+  }
+
+  // Aim for a few chunks per thread so that uneven chunks balance out
+  size_t chunk_size = max(max(grain_size, static_cast<size_t>(1)), (count + 4 * nthreads - 1) / (4 * nthreads));
+  size_t nchunks = (count + chunk_size - 1) / chunk_size;
+  nthreads = min(nthreads, nchunks);
+
+  if (nthreads <= 1 || in_worker) {
+    func(0, count, 0);
+    return;
+  }
+
+  atomic<size_t> next_chunk(0);
+  atomic<bool> failed(false);
+  mutex error_mutex;
+  exception_ptr error;
+
+  function<void(size_t)> job = [&](size_t worker) {
+    try {
+      for (size_t chunk = next_chunk++; chunk < nchunks && !failed; chunk = next_chunk++) {
+        size_t begin = chunk * chunk_size;
+        func(begin, min(begin + chunk_size, count), worker);
+      }
+    } catch (...) {
+      lock_guard<mutex> lock(error_mutex);
+      if (!error) {
+        error = current_exception();
+      }
+      failed = true;
+    }
+  };
+
+  if (!get_thread_pool().run(nthreads, job)) {
+    func(0, count, 0);
+    return;
+  }
+
+  if (error) {
+    rethrow_exception(error);
+  }
+}
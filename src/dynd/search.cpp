@@ -4,9 +4,12 @@
 //
 
 #include <dynd/callables/binary_search_callable.hpp>
+#include <dynd/callables/searchsorted_callable.hpp>
 #include <dynd/search.hpp>
 
 using namespace std;
 using namespace dynd;
 
 DYND_API nd::callable nd::binary_search = nd::make_callable<nd::binary_search_callable>();
+
+DYND_API nd::callable nd::searchsorted = nd::make_callable<nd::searchsorted_callable>();
@@ -233,6 +233,47 @@ void dynd::multistrides_to_axis_perm(intptr_t ndim, int noperands, const intptr_
   }
 }
 
+intptr_t dynd::coalesce_dimensions(intptr_t ndim, intptr_t *shape, int noperands, intptr_t **operstrides)
+{
+  intptr_t res_ndim = 0;
+  for (intptr_t i = 0; i < ndim; ++i) {
+    // A dimension of size one doesn't move any of the operands
+    if (shape[i] == 1) {
+      continue;
+    }
+
+    if (res_ndim > 0) {
+      intptr_t outer = res_ndim - 1;
+      bool contiguous = true;
+      for (int ioperand = 0; ioperand < noperands && contiguous; ++ioperand) {
+        contiguous = operstrides[ioperand][outer] == operstrides[ioperand][i] * shape[i];
+      }
+
+      if (contiguous) {
+        shape[outer] *= shape[i];
+        for (int ioperand = 0; ioperand < noperands; ++ioperand) {
+          operstrides[ioperand][outer] = operstrides[ioperand][i];
+        }
+        continue;
+      }
+    }
+
+    shape[res_ndim] = shape[i];
+    for (int ioperand = 0; ioperand < noperands; ++ioperand) {
+      operstrides[ioperand][res_ndim] = operstrides[ioperand][i];
+    }
+    ++res_ndim;
+  }
+
+  // Every dimension had size one
+  if (res_ndim == 0 && ndim > 0) {
+    shape[0] = 1;
+    res_ndim = 1;
+  }
+
+  return res_ndim;
+}
+
 void dynd::print_shape(std::ostream &o, intptr_t ndim, const intptr_t *shape)
 {
   o << "(";
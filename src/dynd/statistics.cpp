@@ -40,7 +40,8 @@ DYND_API nd::callable nd::max = nd::functional::reduction(
     nd::make_callable<nd::multidispatch_callable<1>>(
         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::max_callable, arithmetic_types>(func_ptr)));
+        nd::callable::make_all<nd::max_callable, arithmetic_types>(func_ptr)),
+    nd::left_associative | nd::commutative);
 
 DYND_API nd::callable nd::mean = nd::make_callable<nd::mean_callable>(ndt::make_type<int64_t>());
 
@@ -53,4 +54,5 @@ DYND_API nd::callable nd::min = nd::functional::reduction(
     nd::make_callable<nd::multidispatch_callable<1>>(
         ndt::make_type<ndt::callable_type>(ndt::make_type<ndt::scalar_kind_type>(),
                                            {ndt::make_type<ndt::scalar_kind_type>()}),
-        nd::callable::make_all<nd::min_callable, arithmetic_types>(func_ptr)));
+        nd::callable::make_all<nd::min_callable, arithmetic_types>(func_ptr)),
+    nd::left_associative | nd::commutative);
@@ -3,6 +3,7 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <algorithm>
 #include <sstream>
 
 #include <dynd/string_encodings.hpp>
@@ -12,6 +13,10 @@
 
 #include <utf8.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 using namespace dynd;
 
@@ -323,8 +328,162 @@ void noerror_append_utf32(uint32_t cp, char *&it_raw, char *DYND_UNUSED(end_raw)
   *it = cp;
   ++it;
 }
+
+template <typename UnitType>
+bool is_ascii_unit(UnitType u) {
+  return u != 0 && u < 0x80;
+}
+
+#ifdef __SSE2__
+
+// SSE2 is part of every x86-64 CPU, so the ASCII scans use it directly. The
+// units are signed in the comparisons, so those from 0x80 up are either
+// negative or not less than 0x80.
+
+size_t full_ascii_blocks(const uint8_t *src, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; count - i >= 16; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(v, zero)) != 0xffff) {
+      break;
+    }
+  }
+  return i;
+}
+
+size_t full_ascii_blocks(const uint16_t *src, size_t count) {
+  const __m128i zero = _mm_setzero_si128(), limit = _mm_set1_epi16(0x80);
+  size_t i = 0;
+  for (; count - i >= 8; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i ascii = _mm_and_si128(_mm_cmpgt_epi16(v, zero), _mm_cmplt_epi16(v, limit));
+    if (_mm_movemask_epi8(ascii) != 0xffff) {
+      break;
+    }
+  }
+  return i;
+}
+
+size_t full_ascii_blocks(const uint32_t *src, size_t count) {
+  const __m128i zero = _mm_setzero_si128(), limit = _mm_set1_epi32(0x80);
+  size_t i = 0;
+  for (; count - i >= 4; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i ascii = _mm_and_si128(_mm_cmpgt_epi32(v, zero), _mm_cmplt_epi32(v, limit));
+    if (_mm_movemask_epi8(ascii) != 0xffff) {
+      break;
+    }
+  }
+  return i;
+}
+
+/**
+ * The number of bytes at the start of [src, src + count) in blocks of 16
+ * that are all ASCII, including NUL.
+ */
+size_t full_utf8_ascii_blocks(const uint8_t *src, size_t count) {
+  size_t i = 0;
+  for (; count - i >= 16; i += 16) {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))) != 0) {
+      break;
+    }
+  }
+  return i;
+}
+
+#else
+
+template <typename UnitType>
+size_t full_ascii_blocks(const UnitType *DYND_UNUSED(src), size_t DYND_UNUSED(count)) {
+  return 0;
+}
+
+size_t full_utf8_ascii_blocks(const uint8_t *DYND_UNUSED(src), size_t DYND_UNUSED(count)) { return 0; }
+
+#endif
+
+/**
+ * The number of units at the start of [src, src + count) that are ASCII
+ * characters other than NUL.
+ */
+template <typename UnitType>
+size_t ascii_run_size(const UnitType *src, size_t count) {
+  size_t i = full_ascii_blocks(src, count);
+  while (i < count && is_ascii_unit(src[i])) {
+    ++i;
+  }
+  return i;
+}
+
+template <typename DstUnitType, typename SrcUnitType>
+void transcode_ascii(const char *&src_raw, const char *src_end_raw, char *&dst_raw, char *dst_end_raw) {
+  const SrcUnitType *src = reinterpret_cast<const SrcUnitType *>(src_raw);
+  DstUnitType *dst = reinterpret_cast<DstUnitType *>(dst_raw);
+  size_t count = std::min<size_t>(reinterpret_cast<const SrcUnitType *>(src_end_raw) - src,
+                                  reinterpret_cast<DstUnitType *>(dst_end_raw) - dst);
+
+  size_t size = ascii_run_size(src, count);
+  // A plain loop that the compiler widens or narrows with vector instructions
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = static_cast<DstUnitType>(src[i]);
+  }
+
+  src_raw += size * sizeof(SrcUnitType);
+  dst_raw += size * sizeof(DstUnitType);
+}
+
+template <typename DstUnitType>
+transcode_ascii_t get_transcode_ascii_from(string_encoding_t src_encoding) {
+  switch (string_encoding_char_size_table[src_encoding]) {
+  case 1:
+    return &transcode_ascii<DstUnitType, uint8_t>;
+  case 2:
+    return &transcode_ascii<DstUnitType, uint16_t>;
+  case 4:
+    return &transcode_ascii<DstUnitType, uint32_t>;
+  default:
+    throw runtime_error("get_transcode_ascii_function: Unrecognized string encoding");
+  }
+}
 } // anonymous namespace
 
+transcode_ascii_t dynd::get_transcode_ascii_function(string_encoding_t dst_encoding, string_encoding_t src_encoding) {
+  switch (string_encoding_char_size_table[dst_encoding]) {
+  case 1:
+    return get_transcode_ascii_from<uint8_t>(src_encoding);
+  case 2:
+    return get_transcode_ascii_from<uint16_t>(src_encoding);
+  case 4:
+    return get_transcode_ascii_from<uint32_t>(src_encoding);
+  default:
+    throw runtime_error("get_transcode_ascii_function: Unrecognized string encoding");
+  }
+}
+
+const char *dynd::find_invalid_utf8(const char *begin, const char *end) {
+  const char *it = begin;
+  while (it < end) {
+    const uint8_t *ascii = reinterpret_cast<const uint8_t *>(it);
+    size_t size = full_utf8_ascii_blocks(ascii, end - it);
+    while (size < static_cast<size_t>(end - it) && ascii[size] < 0x80) {
+      ++size;
+    }
+    it += size;
+    if (it == end) {
+      break;
+    }
+
+    const char *seq = it;
+    uint32_t cp = 0;
+    if (utf8::internal::validate_next(it, end, cp) != utf8::internal::UTF8_OK) {
+      return seq;
+    }
+  }
+
+  return end;
+}
+
 next_unicode_codepoint_t dynd::get_next_unicode_codepoint_function(string_encoding_t encoding,
                                                                    assign_error_mode errmode) {
   switch (encoding) {
@@ -0,0 +1,125 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/kernels/simd.hpp>
+#include <dynd/string_search.hpp>
+
+#ifdef DYND_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+#ifdef DYND_SIMD_DISPATCH
+
+namespace {
+
+/**
+ * Returns one bit for each of the 32 positions starting at ``block`` where
+ * the haystack has the first character of the needle and, ``last_offset``
+ * bytes later, its last character. Only those positions can start a match.
+ */
+typedef uint32_t (*candidates_t)(const char *block, size_t last_offset, char first, char last);
+
+DYND_SIMD_TARGET("sse2") uint32_t candidates_sse2(const char *block, size_t last_offset, char first, char last) {
+  const __m128i first_v = _mm_set1_epi8(first), last_v = _mm_set1_epi8(last);
+
+  uint32_t res = 0;
+  for (int i = 0; i < 2; ++i) {
+    __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+    __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i + last_offset));
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(f, first_v), _mm_cmpeq_epi8(l, last_v));
+    res |= static_cast<uint32_t>(static_cast<uint16_t>(_mm_movemask_epi8(eq))) << (16 * i);
+  }
+
+  return res;
+}
+
+DYND_SIMD_TARGET("avx2") uint32_t candidates_avx2(const char *block, size_t last_offset, char first, char last) {
+  __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + last_offset));
+  __m256i eq =
+      _mm256_and_si256(_mm256_cmpeq_epi8(f, _mm256_set1_epi8(first)), _mm256_cmpeq_epi8(l, _mm256_set1_epi8(last)));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+bool matches_at(const char *s, const char *p, size_t m) {
+  // The first and last characters are already known to match
+  return m <= 2 || memcmp(s + 1, p + 1, m - 2) == 0;
+}
+
+template <candidates_t Candidates>
+size_t simd_find(const char *s, size_t n, const char *p, size_t m) {
+  // The number of positions where a match can start
+  size_t count = n - m + 1;
+
+  size_t i = 0;
+  for (; count - i >= 32; i += 32) {
+    uint32_t mask = Candidates(s + i, m - 1, p[0], p[m - 1]);
+    while (mask != 0) {
+      size_t j = i + __builtin_ctz(mask);
+      if (matches_at(s + j, p, m)) {
+        return j;
+      }
+      mask &= mask - 1;
+    }
+  }
+
+  for (; i < count; ++i) {
+    if (s[i] == p[0] && memcmp(s + i, p, m) == 0) {
+      return i;
+    }
+  }
+
+  return n;
+}
+
+template <candidates_t Candidates>
+size_t simd_rfind(const char *s, size_t n, const char *p, size_t m) {
+  size_t end = n - m + 1;
+
+  for (; end >= 32; end -= 32) {
+    uint32_t mask = Candidates(s + end - 32, m - 1, p[0], p[m - 1]);
+    while (mask != 0) {
+      int bit = 31 - __builtin_clz(mask);
+      size_t j = end - 32 + bit;
+      if (matches_at(s + j, p, m)) {
+        return j;
+      }
+      mask &= ~(static_cast<uint32_t>(1) << bit);
+    }
+  }
+
+  while (end-- > 0) {
+    if (s[end] == p[0] && memcmp(s + end, p, m) == 0) {
+      return end;
+    }
+  }
+
+  return n;
+}
+
+} // anonymous namespace
+
+detail::substring_find_t detail::get_simd_substring_find(bool reverse) {
+  switch (get_simd_isa()) {
+  case simd_avx512:
+  case simd_avx2:
+    return reverse ? &simd_rfind<candidates_avx2> : &simd_find<candidates_avx2>;
+  case simd_sse2:
+    return reverse ? &simd_rfind<candidates_sse2> : &simd_find<candidates_sse2>;
+  default:
+    return NULL;
+  }
+}
+
+#else
+
+detail::substring_find_t detail::get_simd_substring_find(bool DYND_UNUSED(reverse)) { return NULL; }
+
+#endif
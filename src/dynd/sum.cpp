@@ -29,4 +29,5 @@ DYND_API nd::callable nd::sum = nd::functional::reduction(
         nd::callable::make_all<nd::sum_callable,
                                type_sequence<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t,
                                              float16, float, double, dynd::complex<float>, dynd::complex<double>>>(
-            func_ptr)));
+            func_ptr)),
+    nd::left_associative | nd::commutative);
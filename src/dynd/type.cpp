@@ -23,6 +23,7 @@
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/scalar_kind_type.hpp>
 #include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
 #include <dynd/types/uint_kind_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
@@ -32,7 +33,9 @@
 #include <functional>
 #include <iomanip>
 #include <iterator>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -59,6 +62,100 @@ char *dynd::iterdata_broadcasting_terminator_reset(iterdata_common *iterdata, ch
   return data;
 }
 
+namespace {
+
+/**
+ * One part of the intern table, with its own lock. The types are keyed on
+ * their structural hash, which is the same for equal types.
+ */
+struct intern_shard {
+  std::mutex mutex;
+  std::unordered_multimap<size_t, ndt::type> types;
+};
+
+const size_t intern_shard_count = 16;
+
+intern_shard *get_intern_shards() {
+  static intern_shard shards[intern_shard_count];
+  return shards;
+}
+
+size_t hash_combine(size_t seed, size_t value) { return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
+
+// Child types are hashed by their interned instance, which is unique among
+// equal types and usually exists already, so a deep type is not walked again
+size_t hash_child_type(size_t seed, const ndt::type &tp) {
+  return hash_combine(seed, tp.is_builtin() ? static_cast<size_t>(tp.get_id())
+                                            : reinterpret_cast<size_t>(ndt::intern(tp).extended()));
+}
+
+/**
+ * Hashes a type from its id, and from the dimension size, field names and
+ * child types of the common composite types. Only what ``operator==``
+ * compares goes into it, so equal types hash the same. Other types hash on
+ * their id alone and are told apart by the deep comparison.
+ */
+size_t get_structural_hash(const ndt::type &tp) {
+  size_t seed = tp.get_id();
+  switch (tp.get_id()) {
+  case fixed_dim_id:
+    seed = hash_combine(seed, tp.extended<ndt::fixed_dim_type>()->get_fixed_dim_size());
+    return hash_child_type(seed, tp.extended<ndt::base_dim_type>()->get_element_type());
+  case var_dim_id:
+  case fixed_dim_kind_id:
+    return hash_child_type(seed, tp.extended<ndt::base_dim_type>()->get_element_type());
+  case tuple_id:
+    seed = hash_combine(seed, tp.extended<ndt::tuple_type>()->is_variadic());
+    for (const ndt::type &field_tp : tp.extended<ndt::tuple_type>()->get_field_types()) {
+      seed = hash_child_type(seed, field_tp);
+    }
+    return seed;
+  case struct_id:
+    seed = hash_combine(seed, tp.extended<ndt::struct_type>()->is_variadic());
+    for (const std::string &name : tp.extended<ndt::struct_type>()->get_field_names()) {
+      seed = hash_combine(seed, std::hash<std::string>()(name));
+    }
+    for (const ndt::type &field_tp : tp.extended<ndt::struct_type>()->get_field_types()) {
+      seed = hash_child_type(seed, field_tp);
+    }
+    return seed;
+  case option_id:
+    return hash_child_type(seed, tp.extended<ndt::option_type>()->get_value_type());
+  default:
+    return seed;
+  }
+}
+
+} // anonymous namespace
+
+std::atomic<bool> ndt::detail::type_interning(false);
+
+ndt::type ndt::intern(const type &tp) {
+  if (tp.is_builtin() || tp->is_interned()) {
+    return tp;
+  }
+
+  size_t hash = get_structural_hash(tp);
+  intern_shard &shard = get_intern_shards()[hash % intern_shard_count];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto range = shard.types.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (*it->second.extended() == *tp.extended()) {
+      return it->second;
+    }
+  }
+
+  tp->m_interned.store(true, std::memory_order_relaxed);
+  shard.types.emplace(hash, tp);
+
+  return tp;
+}
+
+void ndt::set_type_interning(bool enabled) { detail::type_interning.store(enabled); }
+
+bool ndt::get_type_interning() { return detail::type_interning.load(); }
+
 ndt::type::type(const std::string &rep) { type_from_datashape(rep).swap(*this); }
 
 ndt::type::type(const char *rep_begin, const char *rep_end) { type_from_datashape(rep_begin, rep_end).swap(*this); }
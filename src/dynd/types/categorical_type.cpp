@@ -10,12 +10,17 @@
 #include <dynd/array_range.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/parse_util.hpp>
 #include <dynd/search.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/datashape_parser.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 
+#ifdef DYND_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 using namespace dynd;
 using namespace std;
 
@@ -104,6 +109,92 @@ public:
 //     assign_from_commensurate_category::scalar_to_contiguous_kernel
 // };
 
+std::runtime_error unrecognized_category(const ndt::type &tp, const ndt::type &category_tp, const char *arrmeta,
+                                         const char *data) {
+  stringstream ss;
+  ss << "Unrecognized category value ";
+  category_tp.print_data(ss, arrmeta, data);
+  ss << " assigning to dynd type " << tp;
+  return std::runtime_error(ss.str());
+}
+
+void store_value(char *dst, type_id_t storage_id, uint32_t value) {
+  switch (storage_id) {
+  case uint8_id:
+    *reinterpret_cast<uint8_t *>(dst) = static_cast<uint8_t>(value);
+    break;
+  case uint16_id:
+    *reinterpret_cast<uint16_t *>(dst) = static_cast<uint16_t>(value);
+    break;
+  default:
+    *reinterpret_cast<uint32_t *>(dst) = value;
+    break;
+  }
+}
+
+template <typename T>
+int32_t load_small_int(const char *data) {
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return static_cast<int32_t>(value);
+}
+
+int32_t load_small_int(type_id_t id, const char *data) {
+  switch (id) {
+  case int8_id:
+    return load_small_int<int8_t>(data);
+  case int16_id:
+    return load_small_int<int16_t>(data);
+  case int32_id:
+    return load_small_int<int32_t>(data);
+  case uint16_id:
+    return load_small_int<uint16_t>(data);
+  case uint32_id:
+    return load_small_int<uint32_t>(data);
+  default:
+    return load_small_int<uint8_t>(data);
+  }
+}
+
+#ifdef DYND_SIMD_DISPATCH
+
+/**
+ * Returns one bit for each of the ``count`` categories, a multiple of four,
+ * that is equal to ``value``.
+ */
+DYND_SIMD_TARGET("sse2") uint32_t small_int_matches_sse2(const int32_t *categories, size_t count, int32_t value) {
+  const __m128i value_v = _mm_set1_epi32(value);
+
+  uint32_t res = 0;
+  for (size_t i = 0; i < count; i += 4) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(categories + i));
+    res |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(c, value_v)))) << i;
+  }
+
+  return res;
+}
+
+/**
+ * Encodes integers of type ``T`` by comparing each one with all the
+ * categories at once. The padding repeats the category of value 0, so the
+ * lowest set bit is always the value.
+ */
+template <typename T>
+const char *encode_small_ints(char *dst, intptr_t dst_stride, type_id_t storage_id, const char *src,
+                              intptr_t src_stride, size_t count, const vector<int32_t> &categories) {
+  for (size_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+    uint32_t mask = small_int_matches_sse2(categories.data(), categories.size(), load_small_int<T>(src));
+    if (mask == 0) {
+      return src;
+    }
+    store_value(dst, storage_id, __builtin_ctz(mask));
+  }
+
+  return NULL;
+}
+
+#endif
+
 } // anoymous namespace
 
 /** This function converts the set of char* pointers into a strided immutable
@@ -210,6 +301,87 @@ ndt::categorical_type::categorical_type(type_id_t id, const nd::array &categorie
   }
   this->m_data_size = m_storage_type.get_data_size();
   this->m_data_alignment = (uint8_t)m_storage_type.get_data_alignment();
+
+  make_index();
+}
+
+void ndt::categorical_type::make_index() {
+  size_t category_count = get_category_count();
+  std::string bytes;
+  for (size_t i = 0; i < category_count; ++i) {
+    if (!get_category_bytes(get_category_data_from_value(static_cast<uint32_t>(i)), bytes)) {
+      m_value_from_bytes.clear();
+      return;
+    }
+    m_value_from_bytes[bytes] = static_cast<uint32_t>(i);
+  }
+
+  switch (m_category_tp.get_id()) {
+  case bool_id:
+  case int8_id:
+  case int16_id:
+  case int32_id:
+  case uint8_id:
+  case uint16_id:
+  case uint32_id:
+    if (category_count > 0 && category_count <= 16) {
+      m_small_int_categories.resize((category_count + 3) & ~static_cast<size_t>(3));
+      for (size_t i = 0; i < m_small_int_categories.size(); ++i) {
+        m_small_int_categories[i] = load_small_int(
+            m_category_tp.get_id(), get_category_data_from_value(static_cast<uint32_t>(i < category_count ? i : 0)));
+      }
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+bool ndt::categorical_type::get_category_bytes(const char *category_data, std::string &out) const {
+  switch (m_category_tp.get_id()) {
+  case bool_id:
+  case int8_id:
+  case int16_id:
+  case int32_id:
+  case int64_id:
+  case int128_id:
+  case uint8_id:
+  case uint16_id:
+  case uint32_id:
+  case uint64_id:
+  case uint128_id:
+  case char_id:
+  case fixed_string_id:
+  case fixed_bytes_id:
+    out.assign(category_data, m_category_tp.get_data_size());
+    return true;
+  case float32_id: {
+    float value;
+    memcpy(&value, category_data, sizeof(value));
+    // Negative zero is the same category as zero
+    if (value == 0) {
+      value = 0;
+    }
+    out.assign(reinterpret_cast<const char *>(&value), sizeof(value));
+    return true;
+  }
+  case float64_id: {
+    double value;
+    memcpy(&value, category_data, sizeof(value));
+    if (value == 0) {
+      value = 0;
+    }
+    out.assign(reinterpret_cast<const char *>(&value), sizeof(value));
+    return true;
+  }
+  case string_id: {
+    const dynd::string *value = reinterpret_cast<const dynd::string *>(category_data);
+    out.assign(value->begin(), value->size());
+    return true;
+  }
+  default:
+    return false;
+  }
 }
 
 void ndt::categorical_type::print_data(std::ostream &o, const char *DYND_UNUSED(arrmeta), const char *data) const {
@@ -262,6 +434,16 @@ void ndt::categorical_type::get_shape(intptr_t ndim, intptr_t i, intptr_t *out_s
 }
 
 uint32_t ndt::categorical_type::get_value_from_category(const char *category_arrmeta, const char *category_data) const {
+  if (!m_value_from_bytes.empty()) {
+    std::string bytes;
+    get_category_bytes(category_data, bytes);
+    auto it = m_value_from_bytes.find(bytes);
+    if (it == m_value_from_bytes.end()) {
+      throw unrecognized_category(type(this, true), m_category_tp, category_arrmeta, category_data);
+    }
+    return it->second;
+  }
+
   type dst_tp = make_type<intptr_t>();
   type src_tp[2] = {m_categories.get_type(), m_category_tp};
   const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
@@ -270,11 +452,7 @@ uint32_t ndt::categorical_type::get_value_from_category(const char *category_arr
       nd::binary_search->call(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL, std::map<std::string, ndt::type>())
           .as<intptr_t>();
   if (i < 0) {
-    stringstream ss;
-    ss << "Unrecognized category value ";
-    m_category_tp.print_data(ss, category_arrmeta, category_data);
-    ss << " assigning to dynd type " << type(this, true);
-    throw std::runtime_error(ss.str());
+    throw unrecognized_category(type(this, true), m_category_tp, category_arrmeta, category_data);
   } else {
     return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
   }
@@ -291,16 +469,83 @@ uint32_t ndt::categorical_type::get_value_from_category(const nd::array &categor
     c.assign(category);
   }
 
-  intptr_t i = nd::binary_search(m_categories, c).as<intptr_t>();
-  if (i < 0) {
-    stringstream ss;
-    ss << "Unrecognized category value ";
-    m_category_tp.print_data(ss, c.get()->metadata(), c.data());
-    ss << " assigning to dynd type " << type(this, true);
-    throw std::runtime_error(ss.str());
-  } else {
-    return (uint32_t)unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i);
+  return get_value_from_category(c.get()->metadata(), c.cdata());
+}
+
+void ndt::categorical_type::encode_categories(char *dst, intptr_t dst_stride, const char *src_arrmeta,
+                                              const char *src, intptr_t src_stride, size_t count) const {
+  type_id_t storage_id = m_storage_type.get_id();
+
+#ifdef DYND_SIMD_DISPATCH
+  if (!m_small_int_categories.empty() && get_simd_isa() != simd_none) {
+    const char *unrecognized;
+    switch (m_category_tp.get_id()) {
+    case int8_id:
+      unrecognized = encode_small_ints<int8_t>(dst, dst_stride, storage_id, src, src_stride, count,
+                                               m_small_int_categories);
+      break;
+    case int16_id:
+      unrecognized = encode_small_ints<int16_t>(dst, dst_stride, storage_id, src, src_stride, count,
+                                                m_small_int_categories);
+      break;
+    case int32_id:
+      unrecognized = encode_small_ints<int32_t>(dst, dst_stride, storage_id, src, src_stride, count,
+                                                m_small_int_categories);
+      break;
+    case uint16_id:
+      unrecognized = encode_small_ints<uint16_t>(dst, dst_stride, storage_id, src, src_stride, count,
+                                                 m_small_int_categories);
+      break;
+    case uint32_id:
+      unrecognized = encode_small_ints<uint32_t>(dst, dst_stride, storage_id, src, src_stride, count,
+                                                 m_small_int_categories);
+      break;
+    default:
+      unrecognized = encode_small_ints<uint8_t>(dst, dst_stride, storage_id, src, src_stride, count,
+                                                m_small_int_categories);
+      break;
+    }
+    if (unrecognized != NULL) {
+      throw unrecognized_category(type(this, true), m_category_tp, src_arrmeta, unrecognized);
+    }
+    return;
   }
+#endif
+
+  if (m_value_from_bytes.empty()) {
+    for (size_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+      store_value(dst, storage_id, get_value_from_category(src_arrmeta, src));
+    }
+    return;
+  }
+
+  // One key buffer for all the values, so short categories allocate nothing
+  std::string bytes;
+  for (size_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+    get_category_bytes(src, bytes);
+    auto it = m_value_from_bytes.find(bytes);
+    if (it == m_value_from_bytes.end()) {
+      throw unrecognized_category(type(this, true), m_category_tp, src_arrmeta, src);
+    }
+    store_value(dst, storage_id, it->second);
+  }
+}
+
+nd::array ndt::categorical_type::encode_categories(const nd::array &values) const {
+  nd::array src = values;
+  if (src.get_type().get_id() != fixed_dim_id || src.get_type().at(0) != m_category_tp) {
+    src = nd::empty(values.get_dim_size(), m_category_tp);
+    src.assign(values);
+  }
+
+  intptr_t dim_size = src.get_dim_size();
+  intptr_t src_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src.get()->metadata())->stride;
+  nd::array res = nd::empty(dim_size, m_storage_type);
+  intptr_t dst_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res.get()->metadata())->stride;
+  encode_categories(res.data(), dst_stride, src.get()->metadata() + sizeof(fixed_dim_type_arrmeta), src.cdata(),
+                    src_stride, dim_size);
+
+  return res;
 }
 
 const char *ndt::categorical_type::get_category_arrmeta() const {
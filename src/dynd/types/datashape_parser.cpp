@@ -3,9 +3,12 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <stdexcept>
+#include <unordered_map>
 
 #include <dynd/parse_util.hpp>
 #include <dynd/type_registry.hpp>
@@ -951,7 +954,9 @@ static void get_error_line_column(const char *begin, const char *end, const char
   throw runtime_error("Cannot get line number of error, its position is out of range");
 }
 
-ndt::type dynd::type_from_datashape(const char *datashape_begin, const char *datashape_end) {
+namespace {
+
+ndt::type parse_datashape(const char *datashape_begin, const char *datashape_end) {
   try {
     // Symbol table for intermediate types declared in the datashape
     map<std::string, ndt::type> symtable;
@@ -977,6 +982,112 @@ ndt::type dynd::type_from_datashape(const char *datashape_begin, const char *dat
   }
 }
 
+/**
+ * A bounded LRU cache of parsed types, keyed on the datashape text. Types are
+ * immutable, so a cached one can be handed out to any number of callers.
+ */
+class datashape_cache {
+  std::mutex m_mutex;
+  std::list<std::pair<std::string, ndt::type>> m_entries;
+  std::unordered_map<std::string, std::list<std::pair<std::string, ndt::type>>::iterator> m_index;
+  datashape_cache_stats m_stats;
+
+  void evict(size_t capacity) {
+    while (m_entries.size() > capacity) {
+      m_index.erase(m_entries.back().first);
+      m_entries.pop_back();
+      ++m_stats.evictions;
+    }
+  }
+
+public:
+  static const size_t default_capacity = 1024;
+
+  datashape_cache() { m_stats.capacity = default_capacity; }
+
+  bool find(const std::string &datashape, ndt::type &out_tp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(datashape);
+    if (it == m_index.end()) {
+      ++m_stats.misses;
+      return false;
+    }
+
+    ++m_stats.hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    out_tp = it->second->second;
+    return true;
+  }
+
+  void insert(const std::string &datashape, const ndt::type &tp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Another thread may have parsed the same datashape in the meantime
+    if (m_stats.capacity == 0 || m_index.find(datashape) != m_index.end()) {
+      return;
+    }
+
+    m_entries.emplace_front(datashape, tp);
+    m_index[datashape] = m_entries.begin();
+    evict(m_stats.capacity);
+  }
+
+  datashape_cache_stats get_stats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    datashape_cache_stats res = m_stats;
+    res.size = m_entries.size();
+    return res;
+  }
+
+  void set_capacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.capacity = capacity;
+    evict(capacity);
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    size_t capacity = m_stats.capacity;
+    m_stats = datashape_cache_stats();
+    m_stats.capacity = capacity;
+  }
+};
+
+// Types are parsed from the constructors of static callables, so the cache
+// is created on first use
+datashape_cache &get_datashape_cache() {
+  static datashape_cache cache;
+  return cache;
+}
+
+} // anonymous namespace
+
+ndt::type dynd::type_from_datashape(const char *datashape_begin, const char *datashape_end) {
+  datashape_cache &cache = get_datashape_cache();
+  std::string datashape(datashape_begin, datashape_end);
+
+  ndt::type res;
+  if (!cache.find(datashape, res)) {
+    // The parse happens outside of the lock, it can parse nested datashapes
+    res = parse_datashape(datashape_begin, datashape_end);
+    cache.insert(datashape, res);
+  }
+
+  // A type cached while interning was off is not interned yet
+  if (ndt::get_type_interning()) {
+    res = ndt::intern(res);
+  }
+
+  return res;
+}
+
+datashape_cache_stats dynd::get_datashape_cache_stats() { return get_datashape_cache().get_stats(); }
+
+void dynd::set_datashape_cache_capacity(size_t capacity) { get_datashape_cache().set_capacity(capacity); }
+
+void dynd::clear_datashape_cache() { get_datashape_cache().clear(); }
+
 nd::buffer datashape::parse_type_constr_args(const std::string &str) {
   nd::buffer result;
   std::map<std::string, ndt::type> symtable;
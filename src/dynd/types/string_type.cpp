@@ -24,6 +24,12 @@ void ndt::string_type::get_string_range(const char **out_begin, const char **out
 void ndt::string_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta), char *dst, const char *utf8_begin,
                                             const char *utf8_end, const eval::eval_context *ectx) const
 {
+  // Valid input is copied as is, only invalid input needs converting one code point at a time
+  if (find_invalid_utf8(utf8_begin, utf8_end) == utf8_end) {
+    reinterpret_cast<string *>(dst)->assign(utf8_begin, utf8_end - utf8_begin);
+    return;
+  }
+
   assign_error_mode errmode = ectx->errmode;
   const intptr_t src_charsize = 1;
   intptr_t dst_charsize = string_encoding_char_size_table[string_encoding_utf_8];
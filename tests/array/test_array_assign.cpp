@@ -215,6 +215,43 @@ TYPED_TEST_P(ArrayAssign, ScalarAssignment_Uint64) {
   EXPECT_EQ(20000000000ULL, TestFixture::First::Dereference(ptr_u64));
 }
 
+TEST(ArrayAssign, TransposedAssign) {
+  // C order into Fortran order, with sizes that don't fill the last tiles
+  nd::array a = nd::empty(100, 70, "float64");
+  double *a_data = reinterpret_cast<double *>(a.data());
+  for (int i = 0; i < 7000; ++i) {
+    a_data[i] = i;
+  }
+
+  nd::array b = nd::empty(70, 100, "float64");
+  b.transpose().vals() = a;
+  const double *b_data = reinterpret_cast<const double *>(b.cdata());
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 70; ++j) {
+      EXPECT_EQ(a_data[70 * i + j], b_data[100 * j + i]);
+    }
+  }
+
+  // A transposed view cast into C order, below a leading dimension
+  nd::array c = nd::empty(3, 40, 50, "int32");
+  int32_t *c_data = reinterpret_cast<int32_t *>(c.data());
+  for (int i = 0; i < 6000; ++i) {
+    c_data[i] = i;
+  }
+
+  intptr_t axes[3] = {0, 2, 1};
+  nd::array d = nd::empty(3, 50, 40, "float64");
+  d.vals() = c.permute(3, axes);
+  const double *d_data = reinterpret_cast<const double *>(d.cdata());
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 50; ++j) {
+      for (int k = 0; k < 40; ++k) {
+        EXPECT_EQ(c_data[2000 * i + 50 * k + j], d_data[2000 * i + 40 * j + k]);
+      }
+    }
+  }
+}
+
 #if !(defined(_WIN32) && !defined(_M_X64)) // TODO: How to mark as expected failures in googletest?
 
 TYPED_TEST_P(ArrayAssign, ScalarAssignment_Uint64_LargeNumbers) {
@@ -240,6 +240,29 @@ TEST(ArrayViews, NDimPermute) {
   }
 }
 
+TEST(ArrayViews, NDimPermuteStationaryLeadingAxis) {
+  int vals[2][3][4] = {{{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}},
+                       {{12, 13, 14, 15}, {16, 17, 18, 19}, {20, 21, 22, 23}}};
+
+  nd::array a = nd::empty(ndt::type("2 * 3 * 4 * int32"));
+  a.vals() = vals;
+
+  // The leading axis stays where it is, the two after it are swapped
+  intptr_t axes[3] = {0, 2, 1};
+  nd::array b = a.permute(3, axes);
+  EXPECT_EQ(a.cdata(), b.cdata());
+  EXPECT_EQ(ndt::type("2 * 4 * 3 * int32"), b.get_type());
+  EXPECT_EQ((vector<intptr_t>{2, 4, 3}), b.get_shape());
+  EXPECT_EQ((vector<intptr_t>{48, 4, 16}), b.get_strides());
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        EXPECT_EQ(a(i, j, k).as<int>(), b(i, k, j).as<int>());
+      }
+    }
+  }
+}
+
 TEST(ArrayViews, NDimPermute_BadPerms) {
   nd::array a;
   const int ndim1 = 5;
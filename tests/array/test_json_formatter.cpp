@@ -5,7 +5,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
 #include <dynd/gtest.hpp>
@@ -77,3 +80,87 @@ TEST(JSONFormatter, UniformDim) {
   a = parse_json("var * ?real", "[1.5, null, 3.125, 9.25, null, null]");
   EXPECT_EQ("[1.5,null,3.125,9.25,null,null]", format_json(a).as<std::string>());
 }
+
+TEST(JSONFormatter, NumberLimits) {
+  nd::array a;
+  a = numeric_limits<int64_t>::min();
+  EXPECT_EQ("-9223372036854775808", format_json(a).as<std::string>());
+  a = numeric_limits<int64_t>::max();
+  EXPECT_EQ("9223372036854775807", format_json(a).as<std::string>());
+  a = numeric_limits<uint64_t>::max();
+  EXPECT_EQ("18446744073709551615", format_json(a).as<std::string>());
+  a = (int8_t)-128;
+  EXPECT_EQ("-128", format_json(a).as<std::string>());
+  a = (int32_t)0;
+  EXPECT_EQ("0", format_json(a).as<std::string>());
+  a = (int32_t)9;
+  EXPECT_EQ("9", format_json(a).as<std::string>());
+  a = (int32_t)10;
+  EXPECT_EQ("10", format_json(a).as<std::string>());
+
+  // Floating point values use the fewest digits that round trip
+  a = 0.1;
+  EXPECT_EQ("0.1", format_json(a).as<std::string>());
+  a = 0.1f;
+  EXPECT_EQ("0.1", format_json(a).as<std::string>());
+  double third = 1.0 / 3.0;
+  a = third;
+  EXPECT_EQ(third, strtod(format_json(a).as<std::string>().c_str(), NULL));
+  float third_f = 1.0f / 3.0f;
+  a = third_f;
+  EXPECT_EQ(third_f, strtof(format_json(a).as<std::string>().c_str(), NULL));
+  a = numeric_limits<double>::max();
+  EXPECT_EQ(numeric_limits<double>::max(), strtod(format_json(a).as<std::string>().c_str(), NULL));
+}
+
+TEST(JSONFormatter, Buffer) {
+  json_buffer out;
+  format_json(out, parse_json("{x: int32, y: string}", "{\"x\": 1, \"y\": \"a\\u00e9\"}"));
+  EXPECT_EQ("{\"x\":1,\"y\":\"a\xc3\xa9\"}", out.str());
+
+  // Formatting appends to the buffer, reusing the field prefixes
+  out.write(',');
+  format_json(out, parse_json("{x: int32, y: string}", "{\"x\": -2, \"y\": \"b\"}"));
+  EXPECT_EQ("{\"x\":1,\"y\":\"a\xc3\xa9\"},{\"x\":-2,\"y\":\"b\"}", out.str());
+
+  out.clear();
+  EXPECT_EQ(0u, out.size());
+  format_json(out, parse_json("{x: int32, y: string}", "{\"x\": 3, \"y\": \"c\"}"), true);
+  EXPECT_EQ("[3,\"c\"]", out.str());
+
+  out.clear();
+  format_json(out, parse_json("2 * {\"a b\": {c: bool}}", "[{\"a b\": {\"c\": true}}, {\"a b\": {\"c\": false}}]"));
+  EXPECT_EQ("[{\"a b\":{\"c\":true}},{\"a b\":{\"c\":false}}]", out.str());
+}
+
+TEST(JSONFormatter, BufferFileDescriptor) {
+  FILE *f = tmpfile();
+  ASSERT_TRUE(f != NULL);
+
+  {
+    // A small flush size makes the buffer write while it formats
+    json_buffer out(fileno(f), 16);
+    for (int i = 0; i < 100; ++i) {
+      format_json(out, parse_json("3 * int32", "[1, 22, 333]"));
+      out.write('\n');
+    }
+    EXPECT_GE(16u, out.size());
+    out.flush();
+    EXPECT_EQ(0u, out.size());
+  }
+
+  rewind(f);
+  std::string contents;
+  char buffer[256];
+  size_t count;
+  while ((count = fread(buffer, 1, sizeof(buffer), f)) != 0) {
+    contents.append(buffer, count);
+  }
+  fclose(f);
+
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    expected += "[1,22,333]\n";
+  }
+  EXPECT_EQ(expected, contents);
+}
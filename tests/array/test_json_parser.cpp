@@ -6,11 +6,15 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/callable.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/parse.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
@@ -222,6 +226,122 @@ TEST(JSON, ParserWithMissingValue) {
   EXPECT_TRUE(a.p("y").is_na());
 }
 
+TEST(JSONParser, Indexed) {
+  // Long enough for the two pass parser, with escapes, skipped fields and
+  // missing values
+  std::string json = "[";
+  for (int i = 0; i < 20; ++i) {
+    json += i == 0 ? "" : ",\n";
+    json += "{\"id\": " + std::to_string(i) + ", \"name\": \"item \\\"" + std::to_string(i) +
+            "\\\" [x]\", \"extra\": {\"a\": [1, 2, {\"b\": null}], \"c\": \"}\"}, \"values\": [";
+    for (int j = 0; j < i % 4; ++j) {
+      json += (j == 0 ? "" : ", ") + std::to_string(i * j);
+    }
+    json += i % 3 == 0 ? "]}" : "], \"score\": 1.5 }";
+  }
+  json += "]";
+
+  ndt::type tp("var * {id: int32, name: string, values: var * int64, score: ?float64}");
+  nd::array a = nd::empty(tp);
+  // parse_json falls back to the one pass parser silently, so check that the
+  // two pass parser handles this text on its own
+  bool indexed = parse_indexed_json(a, json.data(), json.data() + json.size(), &eval::default_eval_context);
+  EXPECT_EQ(get_simd_isa() != simd_none, indexed);
+  if (!indexed) {
+    a = parse_json(tp, json.c_str());
+  }
+  nd::array b;
+  {
+    scoped_simd_isa isa(simd_none);
+    b = parse_json(tp, json.c_str());
+  }
+
+  ASSERT_EQ(20, a.get_dim_size());
+  EXPECT_EQ("item \"7\" [x]", a(7, 1).as<std::string>());
+  EXPECT_TRUE(a(6, 3).is_na());
+  EXPECT_EQ(1.5, a(7, 3).as<double>());
+  for (intptr_t i = 0; i < 20; ++i) {
+    EXPECT_EQ(b(i, 0).as<int>(), a(i, 0).as<int>());
+    EXPECT_EQ(b(i, 1).as<std::string>(), a(i, 1).as<std::string>());
+    ASSERT_EQ(b(i, 2).get_dim_size(), a(i, 2).get_dim_size());
+    for (intptr_t j = 0; j < a(i, 2).get_dim_size(); ++j) {
+      EXPECT_EQ(b(i, 2, j).as<int64_t>(), a(i, 2, j).as<int64_t>());
+    }
+  }
+
+  // Errors are reported the same way by both parsers
+  std::string bad = json;
+  bad.replace(bad.rfind("1.5"), 3, "1.x");
+  std::string message, expected_message;
+  try {
+    parse_json(tp, bad.c_str());
+  } catch (const invalid_argument &e) {
+    message = e.what();
+  }
+  {
+    scoped_simd_isa isa(simd_none);
+    try {
+      parse_json(tp, bad.c_str());
+    } catch (const invalid_argument &e) {
+      expected_message = e.what();
+    }
+  }
+  EXPECT_FALSE(message.empty());
+  EXPECT_EQ(expected_message, message);
+}
+
+TEST(JSONParser, Lines) {
+  // A small chunk size splits lines across chunks and makes the buffer grow
+  std::string json = "{\"x\": 1, \"y\": \"one\"}\n"
+                     "{\"x\": 2, \"y\": \"a much longer second value\"}\n"
+                     "   \n"
+                     "{\"y\": \"three\", \"x\": 3}\r\n"
+                     "{\"x\": 4, \"y\": \"four\"}\n"
+                     "{\"x\": 5, \"y\": \"five\"}";
+  ndt::type tp("{x: int32, y: string}");
+
+  stringstream ss(json);
+  nd::array a = parse_json_lines(tp, ss, &eval::default_eval_context, 8);
+  EXPECT_EQ(ndt::type("var * {x: int32, y: string}"), a.get_type());
+  ASSERT_EQ(5, a.get_dim_size());
+  EXPECT_EQ(3, a(2, 0).as<int>());
+  EXPECT_EQ("a much longer second value", a(1, 1).as<std::string>());
+  EXPECT_EQ("five", a(4, 1).as<std::string>());
+
+  std::vector<intptr_t> sizes;
+  std::vector<int> xs;
+  stringstream ss2(json);
+  parse_json_lines(tp, ss2, 2, [&](const nd::array &batch) {
+    sizes.push_back(batch.get_dim_size());
+    for (intptr_t i = 0; i < batch.get_dim_size(); ++i) {
+      xs.push_back(batch(i, 0).as<int>());
+    }
+  }, &eval::default_eval_context, 8);
+  EXPECT_EQ((std::vector<intptr_t>{2, 2, 1}), sizes);
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4, 5}), xs);
+
+  // A last line without a newline that fills the buffer exactly, once or
+  // after it has grown
+  std::string line = "{\"x\": 6, \"y\": \"six six\"}";
+  ASSERT_EQ(24u, line.size());
+  for (size_t chunk_size : {24, 8}) {
+    stringstream ss4(line);
+    a = parse_json_lines(tp, ss4, &eval::default_eval_context, chunk_size);
+    ASSERT_EQ(1, a.get_dim_size());
+    EXPECT_EQ(6, a(0, 0).as<int>());
+    EXPECT_EQ("six six", a(0, 1).as<std::string>());
+  }
+
+  // Errors report the line of the input
+  stringstream ss3("{\"x\": 1, \"y\": \"one\"}\n\n{\"x\": 2, \"y\": 7}\n");
+  try {
+    parse_json_lines(tp, ss3);
+    FAIL() << "expected an error";
+  } catch (const invalid_argument &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("Error parsing JSON at line 3, column 15"));
+  }
+}
+
 /*
 TEST(JSON, DiscoverBool)
 {
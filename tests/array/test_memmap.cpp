@@ -5,8 +5,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
 
 #include <dynd/array.hpp>
@@ -61,3 +64,82 @@ TEST(ArrayMemMap, SimpleString) {
 #endif
 }
 */
+
+static void write_file(const char *fn, const char *data, intptr_t size) {
+  ofstream fout(fn, ios::binary);
+  fout.write(data, size);
+}
+
+static std::string read_file(const char *fn) {
+  ifstream fin(fn, ios::binary);
+  return std::string(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+}
+
+TEST(ArrayMemMap, Bytes) {
+  const char *str = "This is a test of a string.";
+  write_file("test_memmap.bin", str, strlen(str));
+
+  nd::array a = nd::memmap("test_memmap.bin");
+  EXPECT_EQ(ndt::type("27 * uint8"), a.get_type());
+  EXPECT_EQ('T', a(0).as<uint8_t>());
+
+  // Remap a subset of the file, and using a negative index
+  a = nd::memmap("test_memmap.bin", 5, 7);
+  EXPECT_EQ(ndt::type("2 * uint8"), a.get_type());
+  EXPECT_EQ(std::string("is"), std::string(a.cdata(), 2));
+  a = nd::memmap("test_memmap.bin", -7);
+  EXPECT_EQ(std::string("string."), std::string(a.cdata(), 7));
+  a = nd::array();
+
+  remove("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, Typed) {
+  int32_t vals[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  write_file("test_memmap.bin", reinterpret_cast<const char *>(vals), sizeof(vals));
+
+  // A symbolic dimension takes the rest of the file
+  nd::array a = nd::memmap("test_memmap.bin", ndt::type("Fixed * int32"), 8, nd::read_access_flag,
+                           nd::memmap_sequential_flag | nd::memmap_willneed_flag | nd::memmap_populate_flag |
+                               nd::memmap_huge_pages_flag);
+  EXPECT_EQ(ndt::type("6 * int32"), a.get_type());
+  EXPECT_ARRAY_EQ((nd::array{3, 4, 5, 6, 7, 8}), a);
+  EXPECT_EQ(0u, a.get_flags() & nd::write_access_flag);
+
+  a = nd::memmap("test_memmap.bin", ndt::type("2 * 2 * int32"), 16);
+  EXPECT_ARRAY_EQ((nd::array{{5, 6}, {7, 8}}), a);
+  a = nd::memmap("test_memmap.bin", ndt::type("{x: int32, y: int32}"));
+  EXPECT_EQ(2, a(1).as<int>());
+
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("Fixed * string")), type_error);
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("Fixed * int32"), 2), invalid_argument);
+  EXPECT_THROW(nd::memmap("test_memmap.bin", ndt::type("10 * int32")), invalid_argument);
+  EXPECT_THROW(nd::memmap_flush(nd::array{1, 2}), invalid_argument);
+  a = nd::array();
+
+  remove("test_memmap.bin");
+}
+
+TEST(ArrayMemMap, Write) {
+  double vals[] = {1.5, 2.5, 3.5};
+  write_file("test_memmap.bin", reinterpret_cast<const char *>(vals), sizeof(vals));
+
+  nd::array a = nd::memmap("test_memmap.bin", ndt::type("Fixed * float64"), 0, nd::readwrite_access_flags);
+  a(1).assign(10.0);
+  nd::memmap_flush(a(irange() < 2));
+  // Views with a negative stride or no elements flush only what they span
+  a(2).assign(-1.0);
+  nd::memmap_flush(a(irange().by(-1)));
+  nd::memmap_flush(a(irange() < 0));
+  a = nd::array();
+
+  std::string contents = read_file("test_memmap.bin");
+  ASSERT_EQ(sizeof(vals), contents.size());
+  double written[3];
+  memcpy(written, contents.data(), sizeof(written));
+  EXPECT_EQ(1.5, written[0]);
+  EXPECT_EQ(10.0, written[1]);
+  EXPECT_EQ(-1.0, written[2]);
+
+  remove("test_memmap.bin");
+}
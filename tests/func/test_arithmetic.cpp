@@ -8,13 +8,16 @@
 #include <stdexcept>
 
 #include "../test_memory_new.hpp"
+#include "../test_scoped_state.hpp"
 
 #include <dynd/arithmetic.hpp>
 #include <dynd/array.hpp>
+#include <dynd/comparison.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/index.hpp>
 #include <dynd/json_parser.hpp>
 #include <dynd/kernels/arithmetic.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/option.hpp>
 #include <dynd/types/option_type.hpp>
 
@@ -257,6 +260,40 @@ TEST(Arithmetic, Minus) {
   EXPECT_ARRAY_EQ(nd::array({-0.0, -1.0, -2.0, -3.0, -4.0}), -a);
 }
 
+TEST(Arithmetic, SIMDMatchesGeneric) {
+  // Contiguous arrays long enough to exercise the vector loops and their tails
+  nd::array a = nd::empty(1027, ndt::make_type<float>());
+  nd::array b = nd::empty(1027, ndt::make_type<float>());
+  nd::array i = nd::empty(1027, ndt::make_type<int>());
+  for (int j = 0; j < 1027; ++j) {
+    reinterpret_cast<float *>(a.data())[j] = static_cast<float>(j) / 7;
+    reinterpret_cast<float *>(b.data())[j] = static_cast<float>(j % 13 + 1);
+    reinterpret_cast<int *>(i.data())[j] = j - 500;
+  }
+
+  nd::array add, divide, multiply, negate, less, equal;
+  {
+    scoped_simd_isa isa(simd_none);
+    add = a + b;
+    divide = a / b;
+    multiply = i * i;
+    negate = -i;
+    less = a < b;
+    equal = i == i;
+  }
+  EXPECT_EQ(detected_simd_isa(), get_simd_isa());
+
+  EXPECT_ARRAY_EQ(add, a + b);
+  EXPECT_ARRAY_EQ(divide, a / b);
+  EXPECT_ARRAY_EQ(multiply, i * i);
+  EXPECT_ARRAY_EQ(negate, -i);
+  EXPECT_ARRAY_EQ(less, a < b);
+  EXPECT_ARRAY_EQ(equal, i == i);
+
+  // Strided views take the generic loop
+  EXPECT_ARRAY_EQ(add(irange().by(2)), a(irange().by(2)) + b(irange().by(2)));
+}
+
 /*
 TEST(Arithmetic, CompoundDiv)
 {
@@ -8,8 +8,11 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/arithmetic.hpp>
 #include <dynd/array.hpp>
+#include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
@@ -161,6 +164,58 @@ TEST(Callable, Assignment_CallInterface) {
   EXPECT_THROW(af(false), invalid_argument);
 }
 
+TEST(Callable, CallCache) {
+  nd::callable f = nd::functional::elwise([](int x, int y) { return x + y; });
+  f->get_call_cache().clear();
+
+  EXPECT_ARRAY_EQ((nd::array{5, 7, 9}), f(nd::array{1, 2, 3}, nd::array{4, 5, 6}));
+  EXPECT_EQ(1u, f->get_call_cache().size());
+  EXPECT_ARRAY_EQ((nd::array{6, 8, 10}), f(nd::array{2, 3, 4}, nd::array{4, 5, 6}));
+  EXPECT_EQ(1u, f->get_call_cache().size());
+
+  // A different shape is resolved separately
+  EXPECT_ARRAY_EQ((nd::array{5, 7}), f(nd::array{1, 2}, nd::array{4, 5}));
+  EXPECT_EQ(2u, f->get_call_cache().size());
+
+  // A strided view reuses the resolution, but not the kernel
+  nd::array a{0, 1, 2, 3, 4, 5};
+  EXPECT_ARRAY_EQ((nd::array{4, 7, 10}), f(a(irange().by(2)), nd::array{4, 5, 6}));
+  EXPECT_EQ(2u, f->get_call_cache().size());
+
+  f->get_call_cache().set_capacity(1);
+  EXPECT_EQ(1u, f->get_call_cache().size());
+  EXPECT_ARRAY_EQ((nd::array{5, 7, 9}), f(nd::array{1, 2, 3}, nd::array{4, 5, 6}));
+  EXPECT_ARRAY_EQ((nd::array{5, 7}), f(nd::array{1, 2}, nd::array{4, 5}));
+  EXPECT_EQ(1u, f->get_call_cache().size());
+
+  nd::call_cache::invalidate_all();
+  EXPECT_EQ(0u, f->get_call_cache().size());
+
+  f->get_call_cache().set_capacity(0);
+  EXPECT_ARRAY_EQ((nd::array{5, 7}), f(nd::array{1, 2}, nd::array{4, 5}));
+  EXPECT_EQ(0u, f->get_call_cache().size());
+}
+
+TEST(Callable, CallCacheErrorMode) {
+  scoped_eval_context ectx;
+  nd::array a{1.5, 2.0};
+  nd::array b = nd::empty(2, ndt::make_type<int>());
+
+  eval::default_eval_context.errmode = assign_error_nocheck;
+  nd::copy({a}, {{"dst", b}});
+  EXPECT_EQ(1, b(0).as<int>());
+  EXPECT_EQ(2, b(1).as<int>());
+
+  // copy resolves with the default error mode, so a change to it is not
+  // hidden by the cached resolution
+  eval::default_eval_context.errmode = assign_error_fractional;
+  EXPECT_THROW(nd::copy({a}, {{"dst", b}}), runtime_error);
+
+  eval::default_eval_context.errmode = assign_error_nocheck;
+  nd::copy({a}, {{"dst", b}});
+  EXPECT_EQ(1, b(0).as<int>());
+}
+
 /*
 #include <llvm/Bitcode/ReaderWriter.h>
 #include <llvm/IR/LLVMContext.h>
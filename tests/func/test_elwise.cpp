@@ -8,6 +8,8 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/array.hpp>
 #include <dynd/assignment.hpp>
 #include <dynd/callable.hpp>
@@ -15,6 +17,7 @@
 #include <dynd/gtest.hpp>
 #include <dynd/index.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/parallel.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 
 using namespace std;
@@ -218,6 +221,114 @@ TEST(Elwise, Binary_FixedDim) {
   EXPECT_ARRAY_EQ((nd::array{3, 5, 7}), f({{0, 1, 2}, {3, 4, 5}}, {}));
 }
 
+TEST(Elwise, Binary_FixedDim_Parallel) {
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return 2 * x + y; }));
+
+  nd::array a = nd::empty(1000, 3, ndt::make_type<int>());
+  nd::array b = nd::empty(3, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  for (int i = 0; i < 3000; ++i) {
+    a_data[i] = i;
+  }
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 3; ++i) {
+    b_data[i] = -i;
+  }
+
+  nd::array expected = f(a, b);
+
+  nd::array res;
+  {
+    scoped_eval_context ectx;
+    eval::default_eval_context.nthreads = 4;
+    eval::default_eval_context.grain_size = 16;
+    res = f(a, b);
+  }
+
+  EXPECT_ARRAY_EQ(expected, res);
+  EXPECT_EQ(5994, res(999, 0).as<int>());
+  EXPECT_EQ(5996, res(999, 2).as<int>());
+}
+
+TEST(Elwise, Binary_FixedDim_Coalesced) {
+  nd::callable f = nd::functional::elwise(nd::functional::apply([](int x, int y) { return 2 * x + y; }));
+
+  nd::array a = nd::empty(4, 5, 3, ndt::make_type<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  for (int i = 0; i < 60; ++i) {
+    a_data[i] = i;
+  }
+  nd::array b = nd::empty(3, ndt::make_type<int>());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 3; ++i) {
+    b_data[i] = -i;
+  }
+
+  // Contiguous, so the three dimensions are one loop
+  nd::array res = f(a, a);
+  EXPECT_EQ(ndt::type("4 * 5 * 3 * int32"), res.get_type());
+  for (int i = 0; i < 60; ++i) {
+    EXPECT_EQ(3 * i, reinterpret_cast<const int *>(res.cdata())[i]);
+  }
+
+  // Broadcasting the last dimension keeps it as the inner loop
+  res = f(a, b);
+  for (intptr_t i = 0; i < 4; ++i) {
+    for (intptr_t j = 0; j < 5; ++j) {
+      for (intptr_t k = 0; k < 3; ++k) {
+        EXPECT_EQ(2 * a_data[15 * i + 3 * j + k] - k, res(i, j, k).as<int>());
+      }
+    }
+  }
+
+  // A transposed argument reorders the loops
+  nd::array at = a.transpose();
+  res = f(at, at);
+  EXPECT_EQ(ndt::type("3 * 5 * 4 * int32"), res.get_type());
+  for (intptr_t i = 0; i < 3; ++i) {
+    for (intptr_t j = 0; j < 5; ++j) {
+      for (intptr_t k = 0; k < 4; ++k) {
+        EXPECT_EQ(3 * a_data[15 * k + 3 * j + i], res(i, j, k).as<int>());
+      }
+    }
+  }
+
+  // A reversed and strided view
+  nd::array as = a(irange().by(-1), irange().by(2));
+  res = f(as, b);
+  EXPECT_EQ(ndt::type("4 * 3 * 3 * int32"), res.get_type());
+  for (intptr_t i = 0; i < 4; ++i) {
+    for (intptr_t j = 0; j < 3; ++j) {
+      for (intptr_t k = 0; k < 3; ++k) {
+        EXPECT_EQ(2 * a_data[15 * (3 - i) + 6 * j + k] - k, res(i, j, k).as<int>());
+      }
+    }
+  }
+}
+
+TEST(Elwise, ParallelFor) {
+  std::vector<int> visited(10000);
+  std::vector<size_t> worker_count(3);
+  parallel_for(visited.size(), 100, 3, [&](size_t begin, size_t end, size_t worker) {
+    EXPECT_LT(worker, 3u);
+    EXPECT_GE(end - begin, 100u);
+    for (size_t i = begin; i < end; ++i) {
+      ++visited[i];
+    }
+    worker_count[worker] += end - begin;
+  });
+  EXPECT_EQ(visited.size(), static_cast<size_t>(std::count(visited.begin(), visited.end(), 1)));
+  EXPECT_EQ(visited.size(), worker_count[0] + worker_count[1] + worker_count[2]);
+
+  EXPECT_THROW(parallel_for(1000, 10, 4,
+                            [](size_t begin, size_t DYND_UNUSED(end), size_t DYND_UNUSED(worker)) {
+                              if (begin >= 500) {
+                                throw std::runtime_error("chunk failed");
+                              }
+                            }),
+               std::runtime_error);
+}
+
 /*
 // TODO Reenable once there's a convenient way to make the binary callable
 TEST(LiftCallable, Expr_MultiDimVarToVarDim) {
@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/expression.hpp>
+#include <dynd/gtest.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Expression, Leaf) {
+  nd::array a{1, 2, 3};
+  nd::expression e = nd::lazy(a);
+  EXPECT_TRUE(e.is_leaf());
+  EXPECT_ARRAY_EQ(a, e.eval());
+}
+
+TEST(Expression, Binary) {
+  nd::array a{1.5, 2.5, 3.5};
+  nd::array b{2.0, 4.0, 8.0};
+  nd::array c{-1.0, 0.5, 2.0};
+
+  EXPECT_ARRAY_EQ(a + b * c, (nd::lazy(a) + nd::lazy(b) * c).eval());
+  EXPECT_ARRAY_EQ((a - b) / c, ((nd::lazy(a) - b) / c).eval());
+  EXPECT_ARRAY_EQ(-(a * a), (-(nd::lazy(a) * a)).eval());
+}
+
+TEST(Expression, Broadcast) {
+  nd::array a{{1, 2, 3}, {4, 5, 6}};
+  nd::array b{10, 20, 30};
+  nd::array c = 2;
+
+  nd::array res = (nd::lazy(a) * c + b).eval();
+  EXPECT_EQ(ndt::type("2 * 3 * int32"), res.get_type());
+  EXPECT_ARRAY_EQ(a * c + b, res);
+}
+
+TEST(Expression, Blocks) {
+  // More elements than fit in one block of scratch buffers
+  nd::array a = nd::empty(1000, ndt::make_type<double>());
+  nd::array b = nd::empty(1000, ndt::make_type<double>());
+  double *a_data = reinterpret_cast<double *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  for (int i = 0; i < 1000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 0.5 * i;
+  }
+
+  EXPECT_ARRAY_EQ(a * b - a / (b + 1.0), (nd::lazy(a) * b - nd::lazy(a) / (nd::lazy(b) + nd::array(1.0))).eval());
+}
+
+TEST(Expression, Scalar) { EXPECT_ARRAY_EQ(7, (nd::lazy(1) + nd::lazy(2) * nd::lazy(3)).eval()); }
@@ -8,8 +8,13 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
+#include <dynd/arithmetic.hpp>
 #include <dynd/functional.hpp>
 #include <dynd/gtest.hpp>
+#include <dynd/logic.hpp>
+#include <dynd/statistics.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -182,6 +187,44 @@ TEST(Reduction, BuiltinSum_Lift3D_StridedStridedStrided_ReduceBroadcastReduce) {
                                              {{"axes", {0, 2}}}));
 }
 
+TEST(Reduction, Parallel) {
+  nd::array a = nd::empty(10000, ndt::make_type<double>());
+  double *a_data = reinterpret_cast<double *>(a.data());
+  for (int i = 0; i < 10000; ++i) {
+    a_data[i] = (i % 7) - 2.5;
+  }
+  nd::array b = nd::empty(4, 5000, ndt::make_type<int>());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 20000; ++i) {
+    b_data[i] = i % 1000 - 300;
+  }
+
+  nd::callable f =
+      nd::functional::reduction([] { return 100; }, [](const return_wrapper<int> &res, int x) { res += x; },
+                                nd::left_associative | nd::commutative);
+  nd::array expected_f = f(b);
+  nd::array expected_f_axis = f({b}, {{"axes", {1}}});
+  nd::array expected_sum = nd::sum(b);
+  nd::array expected_max = nd::max(b);
+
+  scoped_eval_context ectx;
+  eval::default_eval_context.nthreads = 4;
+  eval::default_eval_context.grain_size = 64;
+
+  // The partial sums only depend on the thread count
+  nd::array res = nd::sum(a);
+  EXPECT_EQ(res.as<double>(), nd::sum(a).as<double>());
+  EXPECT_EQ(4994.0, res.as<double>());
+
+  // The identity is only applied once per result
+  EXPECT_ARRAY_EQ(expected_f, f(b));
+  EXPECT_ARRAY_EQ(expected_f_axis, f({b}, {{"axes", {1}}}));
+  EXPECT_ARRAY_EQ(expected_sum, nd::sum(b));
+  EXPECT_ARRAY_EQ(expected_max, nd::max(b));
+  EXPECT_ARRAY_EQ(-300, nd::min(b));
+  EXPECT_ARRAY_EQ(true, nd::all(nd::empty(1000, ndt::make_type<bool1>()).assign(true)));
+}
+
 TEST(Reduction, Except) {
   // Cannot have a null child
   EXPECT_THROW(nd::functional::reduction([] { return 0; }, nd::callable()), invalid_argument);
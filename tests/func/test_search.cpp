@@ -6,10 +6,14 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/gtest.hpp>
 #include <dynd/search.hpp>
+#include <dynd/types/string_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -19,3 +23,75 @@ TEST(Search, BinarySearch) {
   EXPECT_ARRAY_VALS_EQ(1, nd::binary_search(nd::array{5, 3, 1}, 3));
   EXPECT_ARRAY_VALS_EQ(-1, nd::binary_search(nd::array{5, 3, 1}, 10));
 }
+
+template <typename T>
+static vector<T> to_vector(const nd::array &a) {
+  vector<T> res;
+  for (intptr_t i = 0; i < a.get_dim_size(); ++i) {
+    res.push_back(a(i).as<T>());
+  }
+
+  return res;
+}
+
+TEST(Search, SearchSorted) {
+  nd::array haystack{1, 2, 2, 2, 5};
+  nd::array needles{0, 1, 2, 3, 5, 6};
+  EXPECT_EQ((vector<int64_t>{0, 0, 1, 4, 4, 5}), to_vector<int64_t>(nd::searchsorted(haystack, needles)));
+  EXPECT_EQ((vector<int64_t>{0, 0, 1, 4, 4, 5}),
+            to_vector<int64_t>(nd::searchsorted({haystack, needles}, {{"side", "left"}})));
+  EXPECT_EQ((vector<int64_t>{0, 1, 4, 4, 5, 5}),
+            to_vector<int64_t>(nd::searchsorted({haystack, needles}, {{"side", "right"}})));
+  EXPECT_THROW(nd::searchsorted({haystack, needles}, {{"side", "middle"}}), invalid_argument);
+  EXPECT_THROW(nd::searchsorted({haystack, needles}, {{"side", ""}}), invalid_argument);
+
+  // An empty haystack and a strided one
+  EXPECT_EQ((vector<int64_t>{0, 0}), to_vector<int64_t>(nd::searchsorted(nd::empty(0, ndt::make_type<int>()),
+                                                                         nd::array{1, 2})));
+  nd::array strided{1, 100, 3, 100, 5, 100};
+  EXPECT_EQ((vector<int64_t>{0, 1, 2, 3}),
+            to_vector<int64_t>(nd::searchsorted(strided(irange().by(2)), nd::array{0, 2, 4, 6})));
+
+  // NaNs go last, as they do in sort
+  nd::array floats{1.0, 2.0, numeric_limits<double>::quiet_NaN()};
+  nd::array float_needles{numeric_limits<double>::quiet_NaN(), 1.5};
+  EXPECT_EQ((vector<int64_t>{2, 1}), to_vector<int64_t>(nd::searchsorted(floats, float_needles)));
+  EXPECT_EQ((vector<int64_t>{3, 1}),
+            to_vector<int64_t>(nd::searchsorted({floats, float_needles}, {{"side", "right"}})));
+}
+
+TEST(Search, SearchSortedString) {
+  nd::array haystack{"a", "c", "c", "e"};
+  nd::array needles{"b", "c", "f", ""};
+  EXPECT_EQ((vector<int64_t>{1, 1, 4, 0}), to_vector<int64_t>(nd::searchsorted(haystack, needles)));
+  EXPECT_EQ((vector<int64_t>{1, 3, 4, 0}),
+            to_vector<int64_t>(nd::searchsorted({haystack, needles}, {{"side", "right"}})));
+}
+
+TEST(Search, SearchSortedLarge) {
+  scoped_eval_context ectx;
+  eval::default_eval_context.nthreads = 4;
+
+  // Large enough for the Eytzinger layout and for splitting the needles
+  size_t size = 10000, count = 40000;
+  nd::array haystack = nd::empty(size, ndt::make_type<int32_t>());
+  int32_t *haystack_data = reinterpret_cast<int32_t *>(haystack.data());
+  for (size_t i = 0; i < size; ++i) {
+    haystack_data[i] = static_cast<int32_t>(4 * (i / 2));
+  }
+  nd::array needles = nd::empty(count, ndt::make_type<int32_t>());
+  int32_t *needles_data = reinterpret_cast<int32_t *>(needles.data());
+  for (size_t i = 0; i < count; ++i) {
+    needles_data[i] = static_cast<int32_t>((i * 7919) % (2 * size + 10)) - 5;
+  }
+
+  nd::array left = nd::searchsorted(haystack, needles);
+  nd::array right = nd::searchsorted({haystack, needles}, {{"side", "right"}});
+
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(lower_bound(haystack_data, haystack_data + size, needles_data[i]) - haystack_data,
+              reinterpret_cast<const int64_t *>(left.cdata())[i]);
+    ASSERT_EQ(upper_bound(haystack_data, haystack_data + size, needles_data[i]) - haystack_data,
+              reinterpret_cast<const int64_t *>(right.cdata())[i]);
+  }
+}
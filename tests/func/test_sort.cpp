@@ -6,9 +6,14 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
+#include <vector>
+
+#include "../test_scoped_state.hpp"
 
 #include <dynd/gtest.hpp>
+#include <dynd/index.hpp>
 #include <dynd/sort.hpp>
 
 using namespace std;
@@ -24,11 +29,109 @@ TEST(Sort, 1D) {
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), a);
 }
 
-/*
-TEST(Unique, 1D)
-{
-  nd::array a{0, 0, 1, 2, 2, 3};
-  nd::unique(a);
-  EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3}), a);
+TEST(Sort, Typed) {
+  // Large enough for the radix sort, with negative values and NaNs
+  vector<double> vals(1000);
+  for (size_t i = 0; i < vals.size(); ++i) {
+    vals[i] = ((i * 7919) % 1000) - 500.5;
+  }
+  vals[10] = numeric_limits<double>::quiet_NaN();
+  vals[20] = -numeric_limits<double>::infinity();
+
+  nd::array a = nd::empty(vals.size(), ndt::make_type<double>());
+  copy(vals.begin(), vals.end(), reinterpret_cast<double *>(a.data()));
+  nd::sort(a);
+
+  const double *data = reinterpret_cast<const double *>(a.cdata());
+  EXPECT_EQ(-numeric_limits<double>::infinity(), data[0]);
+  EXPECT_TRUE(is_sorted(data, data + vals.size() - 1));
+  EXPECT_TRUE(std::isnan(data[vals.size() - 1]));
+
+  nd::array b = nd::empty(3000, ndt::make_type<int16_t>());
+  for (int i = 0; i < 3000; ++i) {
+    reinterpret_cast<int16_t *>(b.data())[i] = static_cast<int16_t>((i * 7919) % 3000 - 1500);
+  }
+  nd::sort(b);
+  for (int i = 0; i < 3000; ++i) {
+    EXPECT_EQ(i - 1500, reinterpret_cast<const int16_t *>(b.cdata())[i]);
+  }
+}
+
+TEST(Sort, Strided) {
+  nd::array a = nd::empty(600, ndt::make_type<uint32_t>());
+  for (uint32_t i = 0; i < 600; ++i) {
+    reinterpret_cast<uint32_t *>(a.data())[i] = 600 - i;
+  }
+
+  // Sorting every other element leaves the others in place
+  nd::array b = a(irange().by(2));
+  nd::sort(b);
+  for (uint32_t i = 0; i < 300; ++i) {
+    EXPECT_EQ(2 * i + 2, b(i).as<uint32_t>());
+    EXPECT_EQ(599 - 2 * i, a(2 * i + 1).as<uint32_t>());
+  }
+}
+
+TEST(Sort, Parallel) {
+  scoped_eval_context ectx;
+  eval::default_eval_context.nthreads = 4;
+
+  size_t size = 1 << 17;
+  nd::array a = nd::empty(size, ndt::make_type<int64_t>());
+  for (size_t i = 0; i < size; ++i) {
+    reinterpret_cast<int64_t *>(a.data())[i] = static_cast<int64_t>((i * 104729) % size) - 1000;
+  }
+  nd::sort(a);
+
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(static_cast<int64_t>(i) - 1000, reinterpret_cast<const int64_t *>(a.cdata())[i]);
+  }
+}
+
+template <typename T>
+static vector<T> to_vector(const nd::array &a) {
+  vector<T> res;
+  for (intptr_t i = 0; i < a.get_dim_size(); ++i) {
+    res.push_back(a(i).as<T>());
+  }
+
+  return res;
+}
+
+TEST(Unique, 1D) {
+  nd::array a{3, 1, 3, 2, 1, 3};
+  nd::array res = nd::unique(a);
+  EXPECT_EQ(ndt::type("var * int32"), res.get_type());
+  EXPECT_EQ((vector<int>{3, 1, 2}), to_vector<int>(res));
+
+  nd::array b{0.5, -0.0, std::nan(""), 0.0, 0.5, std::nan("")};
+  res = nd::unique(b);
+  EXPECT_EQ(ndt::type("var * float64"), res.get_type());
+  ASSERT_EQ(3, res.get_dim_size());
+  EXPECT_EQ(0.5, res(0).as<double>());
+  EXPECT_EQ(0.0, res(1).as<double>());
+  EXPECT_TRUE(std::isnan(res(2).as<double>()));
+}
+
+TEST(Unique, String) {
+  nd::array a{"b", "a", "b", "c", "a", "b"};
+  nd::array res = nd::unique(a);
+  EXPECT_EQ(ndt::type("var * string"), res.get_type());
+  ASSERT_EQ(3, res.get_dim_size());
+  EXPECT_EQ("b", res(0).as<std::string>());
+  EXPECT_EQ("a", res(1).as<std::string>());
+  EXPECT_EQ("c", res(2).as<std::string>());
+}
+
+TEST(Unique, CountsAndInverse) {
+  nd::array a{10, 20, 10, 30, 20, 10};
+
+  nd::array res = nd::unique({a}, {{"return_counts", true}, {"return_inverse", true}});
+  EXPECT_EQ(ndt::type("{values: var * int32, counts: var * int64, inverse: 6 * int64}"), res.get_type());
+  EXPECT_EQ((vector<int>{10, 20, 30}), to_vector<int>(res(0)));
+  EXPECT_EQ((vector<int64_t>{3, 2, 1}), to_vector<int64_t>(res(1)));
+  EXPECT_EQ((vector<int64_t>{0, 1, 0, 2, 1, 0}), to_vector<int64_t>(res(2)));
+
+  res = nd::unique({a}, {{"return_inverse", true}});
+  EXPECT_EQ(ndt::type("{values: var * int32, inverse: 6 * int64}"), res.get_type());
 }
-*/
@@ -0,0 +1,52 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include <dynd/comparison.hpp>
+#include <dynd/dictionary.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/string.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Dictionary, Encode) {
+  nd::array a = {"red", "green", "red", "a color name that does not fit in place", "green", "red"};
+  nd::array encoded = nd::dictionary_encode(a);
+  EXPECT_EQ(ndt::type("{codes: 6 * uint32, dictionary: 3 * string}"), encoded.get_type());
+  uint32_t codes[] = {0, 1, 0, 2, 1, 0};
+  EXPECT_ARRAY_EQ(codes, encoded.p("codes"));
+  EXPECT_ARRAY_EQ(nd::array({"red", "green", "a color name that does not fit in place"}), encoded.p("dictionary"));
+
+  EXPECT_ARRAY_EQ(a, nd::dictionary_decode(encoded));
+
+  // Enough distinct values to grow the hash table
+  nd::array b = nd::empty(1000, ndt::make_type<ndt::string_type>());
+  for (int i = 0; i < 1000; ++i) {
+    b(i).assign(std::to_string(i % 300));
+  }
+  encoded = nd::dictionary_encode(b);
+  EXPECT_EQ(300, encoded.p("dictionary").get_dim_size());
+  EXPECT_ARRAY_EQ(b, nd::dictionary_decode(encoded));
+
+  EXPECT_THROW(nd::dictionary_encode(nd::array{1, 2, 3}), type_error);
+  EXPECT_THROW(nd::dictionary_decode(nd::array{1, 2, 3}), type_error);
+}
+
+TEST(Dictionary, Map) {
+  nd::array a = {"abc", "ababc", "abc", "abd", "ababc"};
+  nd::array encoded = nd::dictionary_encode(a);
+
+  EXPECT_ARRAY_EQ(nd::string_find(a, "abc"), nd::dictionary_map(nd::string_find, encoded, {"abc"}));
+  EXPECT_ARRAY_EQ(nd::string_contains(a, "ab"), nd::dictionary_map(nd::string_contains, encoded, {"ab"}));
+  EXPECT_ARRAY_EQ(nd::equal(a, "abc"), nd::dictionary_map(nd::equal, encoded, {"abc"}));
+
+  // Transforming keeps the codes
+  nd::array replaced = nd::dictionary_transform(nd::string_replace, encoded, {"b", "x"});
+  EXPECT_ARRAY_EQ(encoded.p("codes"), replaced.p("codes"));
+  EXPECT_ARRAY_EQ(nd::array({"axc", "axaxc", "axc", "axd", "axaxc"}), nd::dictionary_decode(replaced));
+}
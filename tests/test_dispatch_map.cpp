@@ -7,7 +7,9 @@
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 
+#include <dynd/callable.hpp>
 #include <dynd/dispatcher.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/type_registry.hpp>
@@ -129,3 +131,117 @@ TEST(Dispatcher, Ternary) {
   EXPECT_EQ(0, dispatcher(option_id, int64_id));
 }
 */
+
+namespace {
+
+class tagged_callable : public nd::base_callable {
+public:
+  int tag;
+
+  tagged_callable(const ndt::type &tp, int tag) : base_callable(tp), tag(tag) {}
+
+  ndt::type resolve(nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), nd::call_graph &DYND_UNUSED(cg),
+                    const ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                    size_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
+                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars)) {
+    return dst_tp;
+  }
+};
+
+nd::callable make_tagged(const char *tp, int tag) { return nd::make_callable<tagged_callable>(ndt::type(tp), tag); }
+
+std::vector<ndt::type> dispatch_args(const ndt::type &DYND_UNUSED(dst_tp), size_t nsrc, const ndt::type *src_tp) {
+  return std::vector<ndt::type>(src_tp, src_tp + nsrc);
+}
+
+template <size_t N>
+int lookup(dispatcher<N, nd::callable> &d, std::initializer_list<ndt::type> src_tp) {
+  return static_cast<tagged_callable *>(d(ndt::make_type<void>(), src_tp.size(), src_tp.begin()).get())->tag;
+}
+
+} // unnamed namespace
+
+TEST(Dispatcher, Unary) {
+  dispatcher<1, nd::callable> d(dispatch_args, {make_tagged("(Scalar) -> void", 1), make_tagged("(Int) -> void", 2),
+                                                make_tagged("(int32) -> void", 3), make_tagged("(float32) -> void", 4),
+                                                make_tagged("(float64) -> void", 5)});
+
+  // Every lookup is done twice, once to memoize it and once to hit the memo
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(1, lookup(d, {ndt::make_type<bool1>()}));
+    EXPECT_EQ(2, lookup(d, {ndt::make_type<int16_t>()}));
+    EXPECT_EQ(3, lookup(d, {ndt::make_type<int32_t>()}));
+    EXPECT_EQ(2, lookup(d, {ndt::make_type<int64_t>()}));
+    EXPECT_EQ(4, lookup(d, {ndt::make_type<float>()}));
+    EXPECT_EQ(5, lookup(d, {ndt::make_type<double>()}));
+    EXPECT_EQ(1, lookup(d, {ndt::type("string")}));
+    EXPECT_THROW(lookup(d, {ndt::type("3 * int32")}), out_of_range);
+  }
+
+  // Inserting invalidates previously memoized lookups
+  d.insert(make_tagged("(int64) -> void", 6));
+  d.insert(make_tagged("(Any) -> void", 0));
+  EXPECT_EQ(7u, d.size());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(2, lookup(d, {ndt::make_type<int16_t>()}));
+    EXPECT_EQ(3, lookup(d, {ndt::make_type<int32_t>()}));
+    EXPECT_EQ(6, lookup(d, {ndt::make_type<int64_t>()}));
+    EXPECT_EQ(0, lookup(d, {ndt::type("3 * int32")}));
+  }
+}
+
+TEST(Dispatcher, Binary) {
+  dispatcher<2, nd::callable> d(dispatch_args, {make_tagged("(Any, int64) -> void", 0),
+                                                make_tagged("(Scalar, int64) -> void", 1),
+                                                make_tagged("(int32, int64) -> void", 2),
+                                                make_tagged("(float32, int64) -> void", 3)});
+
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(2, lookup(d, {ndt::make_type<int32_t>(), ndt::make_type<int64_t>()}));
+    EXPECT_EQ(3, lookup(d, {ndt::make_type<float>(), ndt::make_type<int64_t>()}));
+    EXPECT_EQ(1, lookup(d, {ndt::make_type<double>(), ndt::make_type<int64_t>()}));
+    EXPECT_EQ(1, lookup(d, {ndt::make_type<int64_t>(), ndt::make_type<int64_t>()}));
+    EXPECT_EQ(1, lookup(d, {ndt::type("?int32"), ndt::make_type<int64_t>()}));
+    EXPECT_THROW(lookup(d, {ndt::make_type<int64_t>(), ndt::make_type<float>()}), out_of_range);
+  }
+
+  // The memo does not confuse keys that only differ in argument order
+  d.insert(make_tagged("(int64, int32) -> void", 4));
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(2, lookup(d, {ndt::make_type<int32_t>(), ndt::make_type<int64_t>()}));
+    EXPECT_EQ(4, lookup(d, {ndt::make_type<int64_t>(), ndt::make_type<int32_t>()}));
+  }
+}
+
+TEST(Dispatcher, ConcurrentLookup) {
+  dispatcher<2, nd::callable> d(dispatch_args, {make_tagged("(Scalar, Scalar) -> void", 0),
+                                                make_tagged("(int32, Scalar) -> void", 1),
+                                                make_tagged("(Scalar, float64) -> void", 2),
+                                                make_tagged("(int32, float64) -> void", 3)});
+
+  std::vector<ndt::type> tps{ndt::make_type<int16_t>(), ndt::make_type<int32_t>(), ndt::make_type<float>(),
+                             ndt::make_type<double>()};
+
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 100; ++i) {
+        for (const ndt::type &tp0 : tps) {
+          for (const ndt::type &tp1 : tps) {
+            int expected = (tp0.get_id() == int32_id ? 1 : 0) + (tp1.get_id() == float64_id ? 2 : 0);
+            if (lookup(d, {tp0, tp1}) != expected) {
+              ++failures;
+            }
+          }
+        }
+      }
+    });
+  }
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(0, failures);
+}
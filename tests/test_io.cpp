@@ -5,11 +5,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 #include <dynd/gtest.hpp>
 #include <dynd/io.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -23,3 +27,64 @@ TEST(Serialize, FixedDimFixedDim) {
   EXPECT_ARRAY_EQ(bytes("\x00\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00"),
                   nd::serialize(nd::array{{0, 1}, {2, 3}}));
 }
+
+static nd::array binary_round_trip(const nd::array &a) {
+  stringstream ss;
+  nd::write_binary(ss, a);
+  std::string data = ss.str();
+  return nd::read_binary(data.data(), data.data() + data.size());
+}
+
+TEST(BinaryFormat, FixedDim) {
+  nd::array a = {{0, 1, 2}, {3, 4, 5}};
+  EXPECT_ARRAY_EQ(a, binary_round_trip(a));
+
+  // A strided view is written in the default layout
+  nd::array b = binary_round_trip(a(irange(), 1));
+  EXPECT_EQ(ndt::type("2 * int32"), b.get_type());
+  EXPECT_ARRAY_EQ((nd::array{1, 4}), b);
+}
+
+TEST(BinaryFormat, VariableSized) {
+  const char json[] = "[{\"name\": \"a\", \"values\": [1.5, 2.5], \"count\": 3},"
+                     " {\"name\": \"a longer name that needs the heap\", \"values\": [], \"count\": null}]";
+  nd::array a = parse_json("2 * {name: string, values: var * float64, count: ?int32}", json);
+  nd::array b = binary_round_trip(a);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(b).as<std::string>());
+
+  a = parse_json("var * var * string", "[[\"x\"], [], [\"y\", \"z\"]]");
+  b = binary_round_trip(a);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ("[[\"x\"],[],[\"y\",\"z\"]]", format_json(b).as<std::string>());
+}
+
+TEST(BinaryFormat, Corrupt) {
+  std::string junk = "this is not a dynd binary file";
+  EXPECT_THROW(nd::read_binary(junk.data(), junk.data() + junk.size()), runtime_error);
+
+  stringstream ss;
+  nd::write_binary(ss, parse_json("var * string", "[\"a\", \"b\"]"));
+  std::string data = ss.str();
+  EXPECT_THROW(nd::read_binary(data.data(), data.data() + data.size() - 1), runtime_error);
+}
+
+TEST(BinaryFormat, LoadFile) {
+  const char *filename = "test_io_binary.dynd";
+
+  nd::array a = {{1.5, 2.5}, {3.5, 4.5}, {5.5, 6.5}};
+  nd::save_binary(filename, a);
+  nd::array b = nd::load_binary(filename);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_ARRAY_EQ(a, b);
+  // A fixed layout is a read-only view of the file
+  EXPECT_EQ(0u, b.get_flags() & nd::write_access_flag);
+  b = nd::array();
+
+  a = parse_json("3 * string", "[\"one\", \"two\", \"three\"]");
+  nd::save_binary(filename, a);
+  b = nd::load_binary(filename);
+  EXPECT_EQ("[\"one\",\"two\",\"three\"]", format_json(b).as<std::string>());
+
+  remove(filename);
+}
@@ -0,0 +1,62 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/arithmetic.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/kernels/kernel_profiler.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static const nd::kernel_profile_entry *find_strided(const nd::kernel_profile_entry &entry, uint64_t elements) {
+  for (const nd::kernel_profile_entry &child : entry.children) {
+    if (child.calls == 1 && child.elements == elements) {
+      return &child;
+    }
+    if (const nd::kernel_profile_entry *res = find_strided(child, elements)) {
+      return res;
+    }
+  }
+
+  return nullptr;
+}
+
+TEST(KernelProfiler, Add) {
+  nd::array a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  nd::array b = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+  nd::reset_kernel_profile();
+  set_kernel_profiling(true);
+  nd::array c = nd::add(a, b);
+  set_kernel_profiling(false);
+  EXPECT_EQ(11, c(9).as<int>());
+
+  nd::kernel_profile_entry profile = nd::get_kernel_profile();
+  ASSERT_FALSE(profile.children.empty());
+  EXPECT_LE(1u, profile.calls);
+  EXPECT_LE(profile.children[0].self_nanoseconds(), profile.children[0].nanoseconds);
+
+  // The elementwise kernel calls its child once for the whole dimension
+  const nd::kernel_profile_entry *strided = find_strided(profile, 10);
+  ASSERT_NE(nullptr, strided);
+
+  vector<nd::kernel_profile_entry> by_type = nd::get_kernel_profile_by_type();
+  EXPECT_TRUE(any_of(by_type.begin(), by_type.end(),
+                     [&](const nd::kernel_profile_entry &entry) { return entry.name == strided->name; }));
+
+  stringstream ss;
+  nd::print_kernel_profile(ss);
+  EXPECT_NE(std::string::npos, ss.str().find(strided->name + ": 1 calls, 10 elements"));
+
+  // Kernels built while profiling is off are not instrumented
+  nd::reset_kernel_profile();
+  nd::add(a, b);
+  EXPECT_TRUE(nd::get_kernel_profile().children.empty());
+}
@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "test_scoped_state.hpp"
+
+#include <dynd/gtest.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
+#include <dynd/memory_block.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(MemoryAllocator, PoolReusesSizeClass) {
+  nd::pool_memory_allocator allocator;
+
+  char *ptr = allocator.allocate(1000);
+  allocator.deallocate(ptr, 1000);
+  // 1000 and 900 bytes are in the same size class
+  EXPECT_EQ(ptr, allocator.allocate(900));
+
+  // Growing within the size class happens in place
+  EXPECT_EQ(ptr, allocator.reallocate(ptr, 900, 1024, 900));
+  allocator.deallocate(ptr, 1024);
+
+  // Chunks beyond the largest size class go to malloc
+  char *large = allocator.allocate(nd::pool_memory_allocator::max_class_size + 1);
+  large[nd::pool_memory_allocator::max_class_size] = 1;
+  allocator.deallocate(large, nd::pool_memory_allocator::max_class_size + 1);
+}
+
+TEST(MemoryAllocator, Arena) {
+  nd::arena_memory_allocator allocator(4096);
+
+  char *a = allocator.allocate(100);
+  char *b = allocator.allocate(100);
+  EXPECT_EQ(a + 112, b);
+  EXPECT_EQ(4096u, allocator.get_reserved_size());
+
+  // The most recent allocation grows in place
+  EXPECT_EQ(b, allocator.reallocate(b, 100, 1000, 100));
+
+  // Large allocations get their own slab
+  allocator.allocate(2000);
+  EXPECT_EQ(4096u + 2000u, allocator.get_reserved_size());
+
+  allocator.release();
+  EXPECT_EQ(0u, allocator.get_reserved_size());
+}
+
+TEST(MemoryAllocator, PODMemoryBlock) {
+  shared_ptr<nd::arena_memory_allocator> allocator = make_shared<nd::arena_memory_allocator>();
+
+  nd::memory_block memblock = nd::make_memory_block<nd::pod_memory_block>(ndt::make_type<int>(), 64, allocator);
+  int *data = reinterpret_cast<int *>(memblock->alloc(4));
+  for (int i = 0; i < 4; ++i) {
+    data[i] = i;
+  }
+  // Resizing past the chunk grows it in place in the arena
+  data = reinterpret_cast<int *>(memblock->resize(reinterpret_cast<char *>(data), 100));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, data[i]);
+  }
+
+  stringstream ss;
+  memblock->debug_print(ss);
+  EXPECT_NE(std::string::npos, ss.str().find("allocator: arena"));
+  EXPECT_NE(std::string::npos, ss.str().find("allocs: 1, resizes: 1 (0 bytes copied)"));
+}
+
+TEST(MemoryAllocator, Default) {
+  EXPECT_EQ(nd::malloc_allocator(), nd::get_default_memory_allocator());
+
+  shared_ptr<nd::arena_memory_allocator> allocator = make_shared<nd::arena_memory_allocator>();
+  nd::array a;
+  {
+    scoped_default_memory_allocator default_allocator(allocator);
+    a = parse_json("4 * var * int32", "[[2,4,6,8], [1,3,5,7,9], [], [-1,-2,-3]]");
+  }
+  EXPECT_EQ(nd::malloc_allocator(), nd::get_default_memory_allocator());
+
+  EXPECT_LT(0u, allocator->get_reserved_size());
+  EXPECT_EQ(9, a(1, 4).as<int>());
+  EXPECT_EQ(-3, a(3, 2).as<int>());
+
+  // The pool allocator is opt-in
+  {
+    scoped_default_memory_allocator default_allocator(nd::pool_allocator());
+    a = parse_json("4 * var * int32", "[[2,4,6,8], [1,3,5,7,9], [], [-1,-2,-3]]");
+    EXPECT_EQ(nd::pool_allocator(), nd::get_default_memory_allocator());
+  }
+  EXPECT_EQ(9, a(1, 4).as<int>());
+
+  EXPECT_THROW(nd::set_default_memory_allocator(nullptr), invalid_argument);
+}
@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/kernels/simd.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
+#include <dynd/type.hpp>
+
+/**
+ * Restores ``eval::default_eval_context`` when it goes out of scope, so a
+ * test that changes it leaves it as it was even if an assertion fails or an
+ * exception is thrown.
+ */
+class scoped_eval_context {
+  dynd::eval::eval_context m_saved;
+
+public:
+  scoped_eval_context() : m_saved(dynd::eval::default_eval_context) {}
+
+  scoped_eval_context(const scoped_eval_context &) = delete;
+
+  ~scoped_eval_context() { dynd::eval::default_eval_context = m_saved; }
+
+  scoped_eval_context &operator=(const scoped_eval_context &) = delete;
+};
+
+/**
+ * Restores the SIMD instruction set that kernels dispatch on when it goes out
+ * of scope.
+ */
+class scoped_simd_isa {
+  dynd::simd_isa m_saved;
+
+public:
+  scoped_simd_isa() : m_saved(dynd::get_simd_isa()) {}
+
+  explicit scoped_simd_isa(dynd::simd_isa isa) : m_saved(dynd::get_simd_isa()) { dynd::set_simd_isa(isa); }
+
+  scoped_simd_isa(const scoped_simd_isa &) = delete;
+
+  ~scoped_simd_isa() { dynd::set_simd_isa(m_saved); }
+
+  scoped_simd_isa &operator=(const scoped_simd_isa &) = delete;
+};
+
+/**
+ * Sets the allocator that new memory blocks use, restoring the previous one
+ * when it goes out of scope.
+ */
+class scoped_default_memory_allocator {
+  std::shared_ptr<dynd::nd::base_memory_allocator> m_saved;
+
+public:
+  explicit scoped_default_memory_allocator(const std::shared_ptr<dynd::nd::base_memory_allocator> &allocator)
+      : m_saved(dynd::nd::get_default_memory_allocator()) {
+    dynd::nd::set_default_memory_allocator(allocator);
+  }
+
+  scoped_default_memory_allocator(const scoped_default_memory_allocator &) = delete;
+
+  ~scoped_default_memory_allocator() { dynd::nd::set_default_memory_allocator(m_saved); }
+
+  scoped_default_memory_allocator &operator=(const scoped_default_memory_allocator &) = delete;
+};
+
+/**
+ * Turns type interning on or off, restoring the previous setting when it goes
+ * out of scope.
+ */
+class scoped_type_interning {
+  bool m_saved;
+
+public:
+  explicit scoped_type_interning(bool enabled) : m_saved(dynd::ndt::get_type_interning()) {
+    dynd::ndt::set_type_interning(enabled);
+  }
+
+  scoped_type_interning(const scoped_type_interning &) = delete;
+
+  ~scoped_type_interning() { dynd::ndt::set_type_interning(m_saved); }
+
+  scoped_type_interning &operator=(const scoped_type_interning &) = delete;
+};
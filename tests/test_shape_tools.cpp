@@ -137,3 +137,56 @@ TEST(ShapeTools, MultiStridesToAxisPerm_TwoOps)
   EXPECT_EQ(0, axis_perm[2]);
   EXPECT_EQ(1, axis_perm[3]);
 }
+
+TEST(ShapeTools, CoalesceDimensions)
+{
+  intptr_t *stridesptr[2];
+
+  // A C-order array and a broadcast one collapse into one dimension
+  intptr_t shape_c[] = {4, 5, 3};
+  intptr_t strides_c[] = {60, 12, 4};
+  intptr_t strides_b[] = {0, 0, 0};
+  stridesptr[0] = strides_c;
+  stridesptr[1] = strides_b;
+  EXPECT_EQ(1, coalesce_dimensions(3, shape_c, 2, stridesptr));
+  EXPECT_EQ(60, shape_c[0]);
+  EXPECT_EQ(4, strides_c[0]);
+  EXPECT_EQ(0, strides_b[0]);
+
+  // Broadcasting along the last dimension only keeps it apart
+  intptr_t shape_r[] = {4, 5, 3};
+  intptr_t strides_r1[] = {60, 12, 4};
+  intptr_t strides_r2[] = {20, 4, 0};
+  stridesptr[0] = strides_r1;
+  stridesptr[1] = strides_r2;
+  EXPECT_EQ(2, coalesce_dimensions(3, shape_r, 2, stridesptr));
+  EXPECT_EQ(20, shape_r[0]);
+  EXPECT_EQ(3, shape_r[1]);
+  EXPECT_EQ(12, strides_r1[0]);
+  EXPECT_EQ(4, strides_r1[1]);
+  EXPECT_EQ(4, strides_r2[0]);
+  EXPECT_EQ(0, strides_r2[1]);
+
+  // Dimensions of size one are dropped, even between others
+  intptr_t shape_o[] = {2, 1, 6, 1};
+  intptr_t strides_o[] = {48, 100, 8, 7};
+  stridesptr[0] = strides_o;
+  EXPECT_EQ(1, coalesce_dimensions(4, shape_o, 1, stridesptr));
+  EXPECT_EQ(12, shape_o[0]);
+  EXPECT_EQ(8, strides_o[0]);
+
+  // Strided dimensions stay as they are
+  intptr_t shape_s[] = {3, 4};
+  intptr_t strides_s[] = {64, 8};
+  stridesptr[0] = strides_s;
+  EXPECT_EQ(2, coalesce_dimensions(2, shape_s, 1, stridesptr));
+  EXPECT_EQ(3, shape_s[0]);
+  EXPECT_EQ(4, shape_s[1]);
+
+  // Only dimensions of size one leave one of them
+  intptr_t shape_1[] = {1, 1};
+  intptr_t strides_1[] = {8, 8};
+  stridesptr[0] = strides_1;
+  EXPECT_EQ(1, coalesce_dimensions(2, shape_1, 1, stridesptr));
+  EXPECT_EQ(1, shape_1[0]);
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include "../test_scoped_state.hpp"
+
+#include <dynd/array_range.hpp>
+#include <dynd/gtest.hpp>
+#include <dynd/kernels/simd.hpp>
+#include <dynd/types/categorical_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CategoricalType, EncodeSmallInts) {
+  nd::array categories = {3, 7, 10};
+  ndt::type tp = ndt::make_type<ndt::categorical_type>(categories, true);
+  const ndt::categorical_type *cat = tp.extended<ndt::categorical_type>();
+  EXPECT_EQ(ndt::make_type<uint8_t>(), cat->get_storage_type());
+
+  nd::array a = {7, 3, 10, 7, 10, 3};
+  uint8_t codes[] = {1, 0, 2, 1, 2, 0};
+  EXPECT_ARRAY_EQ(codes, cat->encode_categories(a));
+  uint8_t strided_codes[] = {1, 2, 2};
+  EXPECT_ARRAY_EQ(strided_codes, cat->encode_categories(a(irange().by(2))));
+  EXPECT_EQ(2u, cat->get_value_from_category(nd::array(10)));
+  EXPECT_THROW(cat->encode_categories(nd::array{7, 4}), runtime_error);
+
+  // The hash index gives the same values without SIMD
+  scoped_simd_isa isa(simd_none);
+  EXPECT_ARRAY_EQ(codes, cat->encode_categories(a));
+  EXPECT_THROW(cat->encode_categories(nd::array{7, 4}), runtime_error);
+}
+
+TEST(CategoricalType, EncodeHashed) {
+  nd::array categories = {"a category that does not fit in place", "bar", "baz", "foo"};
+  ndt::type tp = ndt::make_type<ndt::categorical_type>(categories, true);
+  const ndt::categorical_type *cat = tp.extended<ndt::categorical_type>();
+
+  nd::array a = {"foo", "bar", "a category that does not fit in place", "baz", "foo"};
+  uint8_t codes[] = {3, 1, 0, 2, 3};
+  EXPECT_ARRAY_EQ(codes, cat->encode_categories(a));
+  EXPECT_EQ(3u, cat->get_value_from_category(nd::array("foo")));
+  EXPECT_THROW(cat->encode_categories(nd::array{"foo", "qux"}), runtime_error);
+
+  // More categories than the SIMD comparison takes
+  nd::array b = nd::old_range(1000, 1300);
+  tp = ndt::make_type<ndt::categorical_type>(b, true);
+  cat = tp.extended<ndt::categorical_type>();
+  EXPECT_EQ(ndt::make_type<uint16_t>(), cat->get_storage_type());
+  nd::array c = nd::empty(600, ndt::make_type<int>());
+  for (int i = 0; i < 600; ++i) {
+    c(i).assign(1000 + (i * 7) % 300);
+  }
+  nd::array values = cat->encode_categories(c);
+  for (int i = 0; i < 600; ++i) {
+    EXPECT_EQ((i * 7) % 300, values(i).as<uint16_t>());
+  }
+
+  // Negative zero is the same category as zero
+  tp = ndt::make_type<ndt::categorical_type>(nd::array{-1.5, 0.0, 2.5}, true);
+  cat = tp.extended<ndt::categorical_type>();
+  uint8_t float_codes[] = {1, 2, 0};
+  EXPECT_ARRAY_EQ(float_codes, cat->encode_categories(nd::array{-0.0, 2.5, -1.5}));
+}
@@ -7,6 +7,8 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/callable.hpp>
 #include <dynd/gtest.hpp>
 #include <dynd/types/datashape_parser.hpp>
@@ -766,3 +768,65 @@ TEST(DataShapeParser, TypeConstructorArgs) {
   a = parse_json(b.get_type(), "[[[1, 2, 3]], [[\"2 * int32\", \"float32\", \"3 * int8\"], [\"x\", \"yz\"]]]");
   EXPECT_EQ(to_str(a), to_str(b));
 }
+
+TEST(DataShapeParser, Cache) {
+  clear_datashape_cache();
+
+  ndt::type a = ndt::type("{x: int32, y: 3 * float64}");
+  ndt::type b = ndt::type("{x: int32, y: 3 * float64}");
+  // The second parse hands out the same instance
+  EXPECT_EQ(a.extended(), b.extended());
+  datashape_cache_stats stats = get_datashape_cache_stats();
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(1u, stats.size);
+
+  // Errors are not cached
+  EXPECT_THROW(ndt::type("{x: int32"), type_error);
+  EXPECT_THROW(ndt::type("{x: int32"), type_error);
+  stats = get_datashape_cache_stats();
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(1u, stats.size);
+
+  // The least recently used types are evicted first
+  set_datashape_cache_capacity(2);
+  ndt::type("int8");
+  ndt::type("{x: int32, y: 3 * float64}");
+  ndt::type("int16");
+  stats = get_datashape_cache_stats();
+  EXPECT_EQ(2u, stats.size);
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(a.extended(), ndt::type("{x: int32, y: 3 * float64}").extended());
+  EXPECT_EQ(3u, get_datashape_cache_stats().hits);
+
+  // A capacity of zero disables the cache
+  set_datashape_cache_capacity(0);
+  EXPECT_EQ(0u, get_datashape_cache_stats().size);
+  EXPECT_NE(a.extended(), ndt::type("{x: int32, y: 3 * float64}").extended());
+  EXPECT_EQ(a, ndt::type("{x: int32, y: 3 * float64}"));
+
+  set_datashape_cache_capacity(1024);
+  clear_datashape_cache();
+}
+
+TEST(DataShapeParser, CacheInterning) {
+  clear_datashape_cache();
+
+  ndt::type a = ndt::type("{x: int32, y: 3 * int32}");
+  EXPECT_FALSE(a->is_interned());
+
+  // A type cached with interning off is interned when it is handed out later
+  ndt::type b, c;
+  {
+    scoped_type_interning interning(true);
+    b = ndt::type("{x: int32, y: 3 * int32}");
+    c = ndt::make_type<ndt::struct_type>(
+        {{ndt::make_type<int>(), "x"}, {ndt::make_type<ndt::fixed_dim_type>(3, ndt::make_type<int>()), "y"}});
+  }
+
+  EXPECT_TRUE(b->is_interned());
+  EXPECT_EQ(c.extended(), b.extended());
+  EXPECT_EQ(a, b);
+
+  clear_datashape_cache();
+}
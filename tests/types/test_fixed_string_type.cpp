@@ -122,3 +122,72 @@ TEST(FixedstringDType, Repr) {
     EXPECT_TYPE_REPR_EQ(s, ndt::type(s));
   }
 }
+
+TEST(FixedStringDType, TranscodeAscii) {
+  const uint16_t src[] = {'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd', ',', ' ', 'h', 'e', 'l', 'l', 'o',
+                          0xe9, 'x', 0, 'y'};
+  const char *src_begin = reinterpret_cast<const char *>(src), *src_end = src_begin + sizeof(src);
+  char dst[32];
+  char *dst_it = dst;
+
+  // Stops at the first non-ASCII character
+  transcode_ascii_t ascii_fn = get_transcode_ascii_function(string_encoding_utf_8, string_encoding_utf_16);
+  const char *src_it = src_begin;
+  ascii_fn(src_it, src_end, dst_it, dst + sizeof(dst));
+  EXPECT_EQ(18 * 2, src_it - src_begin);
+  EXPECT_EQ("hello world, hello", std::string(dst, dst_it));
+
+  // Stops at NUL
+  src_it += 2;
+  ascii_fn(src_it, src_end, dst_it, dst + sizeof(dst));
+  EXPECT_EQ(20 * 2, src_it - src_begin);
+
+  // Stops when the destination is full
+  src_it = src_begin;
+  dst_it = dst;
+  ascii_fn(src_it, src_end, dst_it, dst + 5);
+  EXPECT_EQ("hello", std::string(dst, dst_it));
+  EXPECT_EQ(10, src_it - src_begin);
+}
+
+TEST(FixedStringDType, FindInvalidUtf8) {
+  std::string valid = "plain ascii text that spans several blocks, caf\xc3\xa9, \xf0\x9f\x98\x80 and a NUL ";
+  valid += '\0';
+  valid += "after it";
+  EXPECT_EQ(valid.data() + valid.size(), find_invalid_utf8(valid.data(), valid.data() + valid.size()));
+
+  std::string invalid = valid + "\xc3(" + valid;
+  EXPECT_EQ(invalid.data() + valid.size(), find_invalid_utf8(invalid.data(), invalid.data() + invalid.size()));
+  // A truncated sequence at the end
+  invalid = valid + "\xe2\x82";
+  EXPECT_EQ(invalid.data() + valid.size(), find_invalid_utf8(invalid.data(), invalid.data() + invalid.size()));
+  // An overlong encoding of '/'
+  invalid = valid + "\xc0\xaf";
+  EXPECT_EQ(invalid.data() + valid.size(), find_invalid_utf8(invalid.data(), invalid.data() + invalid.size()));
+}
+
+TEST(FixedStringDType, TranscodeMixed) {
+  // Long ASCII runs with other characters in between, through every encoding and back
+  std::string value = "the first run of plain ascii text, caf\xc3\xa9, then more plain text \xf0\x9f\x98\x80 and "
+                      "the last run of plain ascii, \xe2\x82\xac";
+  nd::array a = value;
+  string_encoding_t encodings[] = {string_encoding_utf_8, string_encoding_utf_16, string_encoding_utf_32};
+  for (string_encoding_t encoding : encodings) {
+    nd::array b = nd::empty(ndt::make_type<ndt::fixed_string_type>(128, encoding));
+    b.assign(a);
+    EXPECT_EQ(value, b.as<std::string>()) << encoding;
+
+    nd::array c = nd::empty(ndt::make_type<ndt::fixed_string_type>(128, string_encoding_utf_8));
+    c.assign(b);
+    EXPECT_EQ(value, c.as<std::string>()) << encoding;
+
+    // Too small a destination
+    nd::array d = nd::empty(ndt::make_type<ndt::fixed_string_type>(16, encoding));
+    EXPECT_THROW(d.assign(a), runtime_error);
+  }
+
+  nd::array ascii = nd::empty(ndt::make_type<ndt::fixed_string_type>(128, string_encoding_ascii));
+  EXPECT_THROW(ascii.assign(a), string_encode_error);
+  ascii.assign("only ascii here, but long enough to take the bulk path");
+  EXPECT_EQ("only ascii here, but long enough to take the bulk path", ascii.as<std::string>());
+}
@@ -7,8 +7,11 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/array.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/kernels/simd.hpp>
 #include <dynd/string.hpp>
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
@@ -459,6 +462,59 @@ TEST(StringType, Count3) {
   EXPECT_ARRAY_EQ(c, nd::string_count(a, b));
 }
 
+TEST(StringType, SearchLong) {
+  // Long haystacks take the vectorized search, and must agree with the scalar one
+  std::string text;
+  for (int i = 0; i < 40; ++i) {
+    text += "lorem ipsum dolor sit amet, ";
+  }
+  text += "needle in the haystack";
+  vector<std::string> needles{"needle", "lorem", "amet, lorem", "x", "k", "t", "haystack", "ipsum dolor sit amet, l",
+                              "needlf", text};
+
+  for (const std::string &needle : needles) {
+    const dynd::string h(text), n(needle);
+    intptr_t find = dynd::string_find(h, n), rfind = dynd::string_rfind(h, n), count = dynd::string_count(h, n);
+    bool contains = dynd::string_contains(h, n);
+
+    {
+      scoped_simd_isa isa(simd_none);
+      EXPECT_EQ(dynd::string_find(h, n), find) << needle;
+      EXPECT_EQ(dynd::string_rfind(h, n), rfind) << needle;
+      EXPECT_EQ(dynd::string_count(h, n), count) << needle;
+      EXPECT_EQ(dynd::string_contains(h, n), contains) << needle;
+    }
+
+    size_t pos = text.find(needle);
+    EXPECT_EQ(pos == std::string::npos ? -1 : static_cast<intptr_t>(pos), find) << needle;
+    pos = text.rfind(needle);
+    EXPECT_EQ(pos == std::string::npos ? -1 : static_cast<intptr_t>(pos), rfind) << needle;
+    EXPECT_EQ(pos != std::string::npos, contains) << needle;
+  }
+
+  EXPECT_EQ(40, dynd::string_count(dynd::string(text), dynd::string("lorem")));
+  EXPECT_EQ(84, dynd::string_count(dynd::string(text), dynd::string("e")));
+}
+
+TEST(StringType, SearchBatched) {
+  // One needle for a whole array is searched for without setting it up per element
+  nd::array a = {"the quick brown fox jumps over the lazy dog", "short", "a much longer line that has no fox in it",
+                 "", "fox fox fox fox fox fox fox fox fox fox fox"};
+  nd::array b = "fox";
+
+  intptr_t find[] = {16, -1, 31, -1, 0};
+  EXPECT_ARRAY_EQ(find, nd::string_find(a, b));
+  intptr_t rfind[] = {16, -1, 31, -1, 40};
+  EXPECT_ARRAY_EQ(rfind, nd::string_rfind(a, b));
+  intptr_t count[] = {1, 0, 1, 0, 11};
+  EXPECT_ARRAY_EQ(count, nd::string_count(a, b));
+  EXPECT_ARRAY_EQ(nd::array({true, false, true, false, true}), nd::string_contains(a, b));
+  EXPECT_EQ("the quick brown cat jumps over the lazy dog", nd::string_replace(a, b, "cat")(0).as<std::string>());
+  EXPECT_EQ("cat cat cat cat cat cat cat cat cat cat cat", nd::string_replace(a, b, "cat")(4).as<std::string>());
+  EXPECT_EQ("lynx lynx lynx lynx lynx lynx lynx lynx lynx lynx lynx",
+            nd::string_replace(a, b, "lynx")(4).as<std::string>());
+}
+
 TEST(StringType, Replace) {
   nd::array a, b, c, d;
 
@@ -591,3 +647,62 @@ TEST(StringType, Iter)
 */
 
 TEST(StringType, IDOf) { EXPECT_EQ(string_id, ndt::id_of<ndt::string_type>::value); }
+
+TEST(StringType, ArenaAssign) {
+  const std::string long_value = "a value too long to be stored inside the string";
+  vector<char> arena(dynd::string::arena_size(long_value.size()) + sizeof(size_t));
+  char *buffer = reinterpret_cast<char *>(reinterpret_cast<uintptr_t>(arena.data() + sizeof(size_t) - 1) &
+                                          ~(sizeof(size_t) - 1));
+
+  dynd::string s;
+  EXPECT_EQ(0u, dynd::string::arena_size(5));
+  s.arena_assign(buffer, "short", 5);
+  EXPECT_FALSE(s.is_arena());
+  EXPECT_EQ("short", std::string(s.begin(), s.end()));
+
+  s.arena_assign(buffer, long_value.data(), long_value.size());
+  EXPECT_TRUE(s.is_arena());
+  EXPECT_EQ(buffer + sizeof(size_t), s.data());
+  EXPECT_EQ(long_value, std::string(s.begin(), s.end()));
+  EXPECT_EQ(long_value.size(), s.capacity());
+
+  // Moving out of the arena copies the value
+  dynd::string t;
+  t = std::move(s);
+  EXPECT_FALSE(t.is_arena());
+  EXPECT_EQ(long_value, std::string(t.begin(), t.end()));
+
+  // A longer value leaves the arena, a shorter one stays in place
+  s.assign("abcdefghijklmnopqrstuvwxyz", 26);
+  EXPECT_TRUE(s.is_arena());
+  s.append(long_value.data(), long_value.size());
+  EXPECT_FALSE(s.is_arena());
+  EXPECT_EQ("abcdefghijklmnopqrstuvwxyz" + long_value, std::string(s.begin(), s.end()));
+}
+
+TEST(StringType, MakeStringArray) {
+  vector<std::string> values{"", "short", "a value too long to be stored inside the string",
+                             "another long value, in the arena"};
+  nd::array a = nd::make_string_array(values);
+  EXPECT_EQ(ndt::type("4 * string"), a.get_type());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], a(i).as<std::string>());
+  }
+
+  const dynd::string *strings = reinterpret_cast<const dynd::string *>(a.cdata());
+  EXPECT_FALSE(strings[1].is_arena());
+  EXPECT_TRUE(strings[2].is_arena());
+  EXPECT_TRUE(strings[3].is_arena());
+
+  // Assigning longer values afterwards moves them to their own memory
+  a(3).vals() = values[2] + values[3];
+  a(2).vals() = "now short";
+  EXPECT_EQ(values[2] + values[3], a(3).as<std::string>());
+  EXPECT_EQ("now short", a(2).as<std::string>());
+  EXPECT_FALSE(strings[3].is_arena());
+
+  // The array keeps the arena alive
+  nd::array b = a(irange() < 2);
+  a = nd::array();
+  EXPECT_EQ("short", b(1).as<std::string>());
+}
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "../test_scoped_state.hpp"
+
 #include <dynd/array.hpp>
 #include <dynd/type.hpp>
 #include <dynd/types/any_kind_type.hpp>
@@ -14,6 +16,7 @@
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/fixed_bytes_kind_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/struct_type.hpp>
 #include <dynd/gtest.hpp>
 
 using namespace std;
@@ -161,6 +164,39 @@ TEST(Type, BasicConstructor) {
   EXPECT_EQ(d, ndt::type(d.str()));
 }
 
+TEST(Type, Intern) {
+  ndt::type a = ndt::make_type<ndt::fixed_dim_type>(3, ndt::make_type<int>());
+  ndt::type b = ndt::make_type<ndt::fixed_dim_type>(3, ndt::make_type<int>());
+  EXPECT_NE(a.extended(), b.extended());
+  EXPECT_FALSE(a->is_interned());
+
+  ndt::type c, d, e;
+  {
+    scoped_type_interning interning(true);
+    c = ndt::make_type<ndt::struct_type>({{ndt::make_type<int>(), "x"}, {a, "y"}});
+    d = ndt::type("{x: int32, y: 3 * int32}");
+    e = ndt::make_type<ndt::fixed_dim_type>(4, ndt::make_type<int>());
+
+    EXPECT_EQ(ndt::type("var * (?int32, {x: int32, y: 3 * int32})").extended(),
+              ndt::type("var*(?int32,{x:int32,y:3*int32})").extended());
+    EXPECT_NE(ndt::type("{x: int32, y: 3 * int32}"), ndt::type("{y: int32, x: 3 * int32}"));
+  }
+  EXPECT_FALSE(ndt::get_type_interning());
+
+  EXPECT_TRUE(c->is_interned());
+  EXPECT_EQ(c.extended(), d.extended());
+  EXPECT_EQ(c, d);
+  EXPECT_NE(e, ndt::intern(a));
+
+  // Types made with interning off still compare by value
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(ndt::intern(a).extended(), ndt::intern(b).extended());
+  EXPECT_EQ(c.extended(), ndt::intern(ndt::type("{x: int32, y: 3 * int32}")).extended());
+
+  // Builtin types are left alone
+  EXPECT_EQ(ndt::make_type<int>(), ndt::intern(ndt::make_type<int>()));
+}
+
 TEST(TypeFor, InitializerList) {
   EXPECT_EQ(ndt::make_type<ndt::fixed_dim_type>(1, ndt::make_type<int>()), ndt::type_for({0}));
   EXPECT_EQ(ndt::make_type<ndt::fixed_dim_type>(2, ndt::make_type<int>()), ndt::type_for({10, -2}));
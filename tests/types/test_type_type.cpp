@@ -8,6 +8,7 @@
 #include <stdexcept>
 
 #include <dynd/array.hpp>
+#include <dynd/types/datashape_parser.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
@@ -54,6 +55,8 @@ TEST(DTypeDType, ScalarRefCount) {
   nd::array a;
   ndt::type d, d2;
   d = ndt::type("Fixed * 12 * int");
+  // The datashape cache keeps a reference to the parsed type
+  clear_datashape_cache();
 
   a = nd::empty(ndt::make_type<ndt::type_type>());
   EXPECT_EQ(1, d.extended()->get_use_count());
@@ -78,6 +81,7 @@ TEST(DTypeDType, StridedArrayRefCount) {
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  clear_datashape_cache();
 
   // 1D Strided Array
   a = nd::empty(10, ndt::make_type<ndt::type_type>());
@@ -124,6 +128,7 @@ TEST(DTypeDType, FixedArrayRefCount) {
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  clear_datashape_cache();
 
   // 1D Fixed Array
   a = nd::empty(ndt::make_fixed_dim(10, ndt::make_type<ndt::type_type>()));
@@ -170,6 +175,7 @@ TEST(DTypeDType, VarArrayRefCount) {
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  clear_datashape_cache();
 
   // 1D Var Array
   a = nd::empty(ndt::make_type<ndt::var_dim_type>(ndt::make_type<ndt::type_type>()));
@@ -222,6 +228,7 @@ TEST(DTypeDType, CStructRefCount) {
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  clear_datashape_cache();
 
   // Single CStruct Instance
   a = nd::empty("{dt: type, more: {a: int32, b: type}, other: string}");
@@ -271,6 +278,7 @@ TEST(DTypeDType, StructRefCount) {
   nd::array a;
   ndt::type d;
   d = ndt::type("Fixed * 12 * int");
+  clear_datashape_cache();
 
   // Single CStruct Instance
   a = nd::empty("{dt: type, more: {a: int32, b: type}, other: string}")(0 <= irange() < 2);